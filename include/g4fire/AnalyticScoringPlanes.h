@@ -0,0 +1,72 @@
+#ifndef G4FIRE_ANALYTICSCORINGPLANES_H
+#define G4FIRE_ANALYTICSCORINGPLANES_H
+
+#include <array>
+#include <vector>
+
+#include "G4GDMLParser.hh"
+#include "G4Step.hh"
+
+namespace g4fire {
+
+class CrossingFilter;
+
+/**
+ * Scoring planes whose crossings are found analytically.
+ *
+ * Instead of loading the scoring planes into a parallel world (which
+ * adds a second navigator and limits the steps of every particle at
+ * every plane boundary), the planes are described by their position
+ * along the axis they are perpendicular to and their extent in the other
+ * two axes. The crossings are then found from the pre and post step
+ * points of every step, assuming the particle travels in a straight
+ * line between the two. The crossings are recorded by the scoring plane
+ * sensitive detector referenced by the plane volume.
+ *
+ * The planes are read from the same GDML as the parallel world: every
+ * daughter of the world volume has to be an unrotated box and its
+ * thinnest dimension defines the axis the plane is perpendicular to.
+ */
+class AnalyticScoringPlanes {
+ public:
+  /**
+   * Read the planes from the input parser.
+   *
+   * The sensitive detectors referenced by the planes need to exist already.
+   *
+   * @param[in] parser GDML parser that has read the scoring plane GDML
+   */
+  AnalyticScoringPlanes(G4GDMLParser *parser);
+
+  /// Destructor
+  ~AnalyticScoringPlanes() = default;
+
+  /**
+   * Find and record all crossings of planes during the input step.
+   *
+   * @param[in] step current step
+   */
+  void stepping(const G4Step *step);
+
+ private:
+  /// A single plane
+  struct Plane {
+    /// position along the axis perpendicular to the plane
+    double position;
+    /// center of the plane in the other two axes
+    std::array<double, 2> center;
+    /// half widths of the plane in the other two axes
+    std::array<double, 2> half_width;
+    /// copy number of the plane
+    int copy_number;
+    /// sensitive detector recording the crossings
+    CrossingFilter *recorder;
+  };
+
+  /// Planes perpendicular to each axis, sorted by their position
+  std::array<std::vector<Plane>, 3> planes_;
+};
+
+}  // namespace g4fire
+
+#endif  // G4FIRE_ANALYTICSCORINGPLANES_H
@@ -96,9 +96,6 @@ class DarkBrem : public XsecBiasingOperator {
   /// volume we want to bias in
   std::string volume_;
 
-  /// factor we want to bias by
-  double factor_;
-
   /// should we bias all electrons? (or only the primary)
   bool bias_all_;
 
@@ -0,0 +1,157 @@
+#ifndef G4FIRE_BIASOPERATORS_FORCEDINTERACTION_H_
+#define G4FIRE_BIASOPERATORS_FORCEDINTERACTION_H_
+
+#include "G4ILawTruncatedExp.hh"
+#include "G4VBiasingOperation.hh"
+
+#include "g4fire/XsecBiasingOperator.h"
+
+namespace g4fire {
+namespace biasoperators {
+
+/**
+ * Occurence biasing operation that forces an interaction to happen
+ * within a maximum distance.
+ *
+ * The interaction length is sampled from an exponential law truncated
+ * at the maximum distance, so the interaction always happens before it.
+ * The biasing process interface weights the track by the ratio of the
+ * physical and truncated laws.
+ */
+class ForcedInteractionOperation : public G4VBiasingOperation {
+ public:
+  /** Constructor */
+  ForcedInteractionOperation(const G4String& name)
+      : G4VBiasingOperation(name), law_("truncatedExpLaw-" + name) {}
+
+  /** Destructor */
+  ~ForcedInteractionOperation() = default;
+
+  /**
+   * Set the cross section of the process and the distance to force
+   * it within and sample a new interaction length.
+   *
+   * @param[in] xsec unbiased cross section (inverse interaction length)
+   * @param[in] distance maximum distance to interact within
+   */
+  void Force(G4double xsec, G4double distance) {
+    law_.SetForceCrossSection(xsec);
+    law_.SetMaximumDistance(distance);
+    law_.Sample();
+  }
+
+  /// The truncated law to sample the interaction length from
+  const G4VBiasingInteractionLaw* ProvideOccurenceBiasingInteractionLaw(
+      const G4BiasingProcessInterface*, G4ForceCondition&) final override {
+    return &law_;
+  }
+
+  /// Do not change the final state
+  G4VParticleChange* ApplyFinalStateBiasing(const G4BiasingProcessInterface*,
+                                            const G4Track*, const G4Step*,
+                                            G4bool&) final override {
+    return nullptr;
+  }
+
+  /// Not a non-physics operation
+  G4double DistanceToApplyOperation(const G4Track*, G4double,
+                                    G4ForceCondition*) final override {
+    return DBL_MAX;
+  }
+
+  /// Not a non-physics operation
+  G4VParticleChange* GenerateBiasingFinalState(const G4Track*,
+                                               const G4Step*) final override {
+    return nullptr;
+  }
+
+ private:
+  /// exponential law truncated at the maximum distance
+  G4ILawTruncatedExp law_;
+};  // ForcedInteractionOperation
+
+/**
+ * Force a process to happen within the volume being biased
+ *
+ * Instead of scaling the cross section by a fixed factor, the
+ * interaction length of the process is sampled from an exponential
+ * truncated at the distance to the boundary of the current volume
+ * along the direction of the track. Every track entering the volume
+ * above the threshold then undergoes the process inside of it and
+ * is given the weight of doing so, which the stepping action folds
+ * into the event weight. The hits of the track and its products do not
+ * carry it again.
+ *
+ * The distance to the boundary is re-computed on every step, so
+ * other processes and daughter volumes may still cut the track short.
+ */
+class ForcedInteraction : public XsecBiasingOperator {
+ public:
+  /**
+   * Constructor
+   *
+   * Calls parent constructor and allows
+   * accesss to configuration parameters.
+   */
+  ForcedInteraction(std::string name, const fire::config::Parameters& p);
+
+  /** Destructor */
+  ~ForcedInteraction() = default;
+
+  /** Method called at the beginning of a run. */
+  void StartRun();
+
+  /**
+   * @return Method that returns the biasing operation that will be used
+   *         to force the process to occur within the volume.
+   */
+  G4VBiasingOperation* ProposeOccurenceBiasingOperation(
+      const G4Track* track,
+      const G4BiasingProcessInterface* callingProcess) final override;
+
+  /// Return the process to bias
+  virtual std::string getProcessToBias() const { return process_; }
+
+  /// Return the particle to bias
+  virtual std::string getParticleToBias() const { return particle_; }
+
+  /// Return the volume to bias in
+  virtual std::string getVolumeToBias() const { return volume_; }
+
+  /**
+   * Record the configuration to the run header
+   *
+   * @param[in,out] header RunHeader to record to
+   */
+  virtual void RecordConfig(fire::RunHeader& header) const {
+    header.set<std::string>("BiasOperator::ForcedInteraction::Volume",
+                            volume_);
+    header.set<std::string>("BiasOperator::ForcedInteraction::Process",
+                            process_);
+    header.set<std::string>("BiasOperator::ForcedInteraction::Particle",
+                            particle_);
+    header.set<float>("BiasOperator::ForcedInteraction::Threshold",
+                      threshold_);
+  }
+
+ private:
+  /// The operation forcing the interaction
+  ForcedInteractionOperation* force_operation_{nullptr};
+
+  /// The volume to bias in
+  std::string volume_;
+
+  /// The process to force
+  std::string process_;
+
+  /// The particle to bias
+  std::string particle_;
+
+  /// Minimum kinetic energy [MeV] to allow a track to be biased
+  double threshold_;
+};  // ForcedInteraction
+
+}  // namespace biasoperators
+}  // namespace g4fire
+
+#endif  // G4FIRE_BIASOPERATORS_FORCEDINTERACTION_H_
@@ -55,9 +55,6 @@ class NeutronInelastic : public XsecBiasingOperator {
   /// The volume to bias in
   std::string volume_;
 
-  /// The biasing factor
-  double factor_;
-
   /// Minimum kinetic energy [MeV] to allow a track to be biased
   double threshold_;
 
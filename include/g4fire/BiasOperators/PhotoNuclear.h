@@ -50,6 +50,9 @@ class PhotoNuclear : public XsecBiasingOperator {
   /** Geant4 gamma conversion process name. */
   static const std::string CONVERSION_PROCESS;
 
+  /** Gamma conversion process, resolved in StartRun if it is biased */
+  const G4VProcess* conversion_process_{nullptr};
+
   /** Cross-section biasing operation for conversion process */
   G4BOptnChangeCrossSection* emXsecOperation{nullptr};
 
@@ -65,9 +68,6 @@ class PhotoNuclear : public XsecBiasingOperator {
   /** minimum kinetic energy [MeV] for a track to be biased */
   double threshold_;
 
-  /** factor to bias PN by */
-  double factor_;
-
   /// Should we down-bias the gamma conversion process?
   bool down_bias_conv_;
 
@@ -0,0 +1,196 @@
+#ifndef G4FIRE_BIASOPERATORS_SECONDARYSPLITTING_H_
+#define G4FIRE_BIASOPERATORS_SECONDARYSPLITTING_H_
+
+#include <vector>
+
+#include "G4VBiasingOperation.hh"
+
+#include "g4fire/XsecBiasingOperator.h"
+
+namespace g4fire {
+namespace biasoperators {
+
+/**
+ * Final state biasing operation that splits selected secondaries.
+ *
+ * The wrapped process generates its final state as usual and each
+ * selected secondary is then replaced by N copies of itself carrying
+ * 1/N of its weight.
+ */
+class SplitFinalStateOperation : public G4VBiasingOperation {
+ public:
+  /**
+   * Constructor
+   *
+   * @param[in] name name of the operation
+   * @param[in] split_factor number of copies of each selected secondary
+   * @param[in] pdg_ids secondaries to split, all of them if empty
+   * @param[in] min_kinetic_energy secondaries below it are not split [MeV]
+   */
+  SplitFinalStateOperation(const G4String& name, int split_factor,
+                           const std::vector<int>& pdg_ids,
+                           double min_kinetic_energy)
+      : G4VBiasingOperation(name),
+        split_factor_{split_factor},
+        pdg_ids_{pdg_ids},
+        min_kinetic_energy_{min_kinetic_energy} {}
+
+  /** Destructor */
+  ~SplitFinalStateOperation() = default;
+
+  /// Not an occurence operation
+  const G4VBiasingInteractionLaw* ProvideOccurenceBiasingInteractionLaw(
+      const G4BiasingProcessInterface*, G4ForceCondition&) final override {
+    return nullptr;
+  }
+
+  /**
+   * Run the wrapped process and split the selected secondaries it
+   * produced.
+   *
+   * The secondaries are weighted by the process while they are added
+   * so that the split weights are kept, the occurence weight (if any)
+   * is still applied on top of them by the biasing interface.
+   */
+  G4VParticleChange* ApplyFinalStateBiasing(
+      const G4BiasingProcessInterface* callingProcess, const G4Track* track,
+      const G4Step* step, G4bool& forceFinalState) final override;
+
+  /// Not a non-physics operation
+  G4double DistanceToApplyOperation(const G4Track*, G4double,
+                                    G4ForceCondition*) final override {
+    return DBL_MAX;
+  }
+
+  /// Not a non-physics operation
+  G4VParticleChange* GenerateBiasingFinalState(const G4Track*,
+                                               const G4Step*) final override {
+    return nullptr;
+  }
+
+ private:
+  /// Should this secondary be split?
+  bool isSelected(const G4Track* secondary) const;
+
+  /// Number of copies of each selected secondary
+  int split_factor_;
+
+  /// PDG IDs of the secondaries to split, all of them if empty
+  std::vector<int> pdg_ids_;
+
+  /// Minimum kinetic energy [MeV] of a secondary to be split
+  double min_kinetic_energy_;
+};  // SplitFinalStateOperation
+
+/**
+ * Split the products of a process
+ *
+ * After the process happens in the volume being biased, the selected
+ * secondaries are each replaced by split_factor copies with 1/split_factor
+ * of the weight. The copies are tracked independently, so a single rare
+ * interaction gives several samples of its products downstream.
+ *
+ * The occurence of the process can also be biased by a factor like in
+ * the other operators, since only one operator can be attached to a
+ * volume. A factor of one leaves the occurence alone.
+ *
+ * The occurence weight goes into the event weight like for the other
+ * operators. The 1/split_factor of the copies does not since the expected
+ * number of products does not change, it is only carried by the hits
+ * (calorimeter hit contributions) of the copies and their descendants.
+ * Analyses weight each hit by the event weight times the hit weight.
+ */
+class SecondarySplitting : public XsecBiasingOperator {
+ public:
+  /**
+   * Constructor
+   *
+   * Calls parent constructor and allows
+   * accesss to configuration parameters.
+   */
+  SecondarySplitting(std::string name, const fire::config::Parameters& p);
+
+  /** Destructor */
+  ~SecondarySplitting() = default;
+
+  /** Method called at the beginning of a run. */
+  void StartRun();
+
+  /**
+   * @return Method that returns the biasing operation that will be used
+   *         to bias the occurence of the process, if a factor is given.
+   */
+  G4VBiasingOperation* ProposeOccurenceBiasingOperation(
+      const G4Track* track,
+      const G4BiasingProcessInterface* callingProcess) final override;
+
+  /// Return the process to bias
+  virtual std::string getProcessToBias() const { return process_; }
+
+  /// Return the particle to bias
+  virtual std::string getParticleToBias() const { return particle_; }
+
+  /// Return the volume to bias in
+  virtual std::string getVolumeToBias() const { return volume_; }
+
+  /**
+   * Record the configuration to the run header
+   *
+   * @param[in,out] header RunHeader to record to
+   */
+  virtual void RecordConfig(fire::RunHeader& header) const {
+    header.set<std::string>("BiasOperator::SecondarySplitting::Volume",
+                            volume_);
+    header.set<std::string>("BiasOperator::SecondarySplitting::Process",
+                            process_);
+    header.set<std::string>("BiasOperator::SecondarySplitting::Particle",
+                            particle_);
+    header.set<float>("BiasOperator::SecondarySplitting::Factor", factor_);
+    header.set<float>("BiasOperator::SecondarySplitting::Threshold",
+                      threshold_);
+    header.set<int>("BiasOperator::SecondarySplitting::Split Factor",
+                    split_factor_);
+  }
+
+ protected:
+  /**
+   * Propose to split the products of the process.
+   *
+   * @param track handle to the track undergoing the process
+   * @param callingProcess handle to process that is happening
+   * @return the splitting operation if the process is the one we bias
+   */
+  G4VBiasingOperation* ProposeFinalStateBiasingOperation(
+      const G4Track* track,
+      const G4BiasingProcessInterface* callingProcess) final override;
+
+ private:
+  /// The operation splitting the secondaries
+  SplitFinalStateOperation* split_operation_{nullptr};
+
+  /// The volume to bias in
+  std::string volume_;
+
+  /// The process whose products are split
+  std::string process_;
+
+  /// The particle undergoing the process
+  std::string particle_;
+
+  /// Minimum kinetic energy [MeV] to allow a track to be biased
+  double threshold_;
+
+  /// Number of copies of each selected secondary
+  int split_factor_;
+
+  /// PDG IDs of the secondaries to split, all of them if empty
+  std::vector<int> pdg_ids_;
+
+  /// Minimum kinetic energy [MeV] of a secondary to be split
+  double min_kinetic_energy_;
+};  // SecondarySplitting
+
+}  // namespace biasoperators
+}  // namespace g4fire
+
+#endif  // G4FIRE_BIASOPERATORS_SECONDARYSPLITTING_H_
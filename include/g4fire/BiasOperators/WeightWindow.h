@@ -0,0 +1,197 @@
+#ifndef G4FIRE_BIASOPERATORS_WEIGHTWINDOW_H_
+#define G4FIRE_BIASOPERATORS_WEIGHTWINDOW_H_
+
+#include <vector>
+
+#include "G4ParticleChange.hh"
+#include "G4VBiasingOperation.hh"
+
+#include "g4fire/XsecBiasingOperator.h"
+
+namespace g4fire {
+namespace biasoperators {
+
+/**
+ * The bounds on the weight of a track within a band of kinetic energy
+ */
+struct Window {
+  /// Upper edge of the energy band [MeV]
+  double max_energy;
+
+  /// Tracks below this weight play russian roulette
+  double lower_weight;
+
+  /// Tracks above this weight are split
+  double upper_weight;
+
+  /// Weight given to the tracks surviving the roulette
+  double survival_weight;
+};
+
+/**
+ * Non-physics biasing operation bringing the weight of a track
+ * back into its window.
+ *
+ * A track heavier than the upper bound of the window is split into
+ * copies that are within it, a track lighter than the lower bound is
+ * killed with a probability chosen so that the survivors have the
+ * survival weight. Both keep the expected weight, so the weight of the
+ * event is left alone and the changes are only carried by the tracks.
+ */
+class WeightWindowOperation : public G4VBiasingOperation {
+ public:
+  /**
+   * Constructor
+   *
+   * @param[in] name name of the operation
+   * @param[in] max_split maximum number of copies to split a track into
+   */
+  WeightWindowOperation(const G4String& name, int max_split)
+      : G4VBiasingOperation(name), max_split_{max_split} {}
+
+  /** Destructor */
+  ~WeightWindowOperation() = default;
+
+  /**
+   * Set the window to bring the track into at the end of this step
+   *
+   * @param[in] window the window of the energy of the track
+   */
+  void SetWindow(const Window* window) { window_ = window; }
+
+  /// Not an occurence operation
+  const G4VBiasingInteractionLaw* ProvideOccurenceBiasingInteractionLaw(
+      const G4BiasingProcessInterface*, G4ForceCondition&) final override {
+    return nullptr;
+  }
+
+  /// Not a final state operation
+  G4VParticleChange* ApplyFinalStateBiasing(const G4BiasingProcessInterface*,
+                                            const G4Track*, const G4Step*,
+                                            G4bool&) final override {
+    return nullptr;
+  }
+
+  /// Applied at the end of the step, whatever limited it
+  G4double DistanceToApplyOperation(const G4Track*, G4double,
+                                    G4ForceCondition* condition) final override {
+    *condition = Forced;
+    return DBL_MAX;
+  }
+
+  /// Split or roulette the track depending on its weight
+  G4VParticleChange* GenerateBiasingFinalState(const G4Track* track,
+                                               const G4Step*) final override;
+
+ private:
+  /// Particle change of the track and its copies
+  G4ParticleChange particle_change_;
+
+  /// Window to bring the track into
+  const Window* window_{nullptr};
+
+  /// Maximum number of copies to split a track into
+  int max_split_;
+};  // WeightWindowOperation
+
+/**
+ * Keep the weights of tracks within windows
+ *
+ * Weight windows (importance sampling) spend the simulation time on the
+ * tracks that matter for the output. Within the volume being biased, the
+ * weight of each track is compared at every step to the window of its
+ * kinetic energy. Tracks below the window play russian roulette and tracks
+ * above it are split, so tracks that have been down-weighted upstream
+ * (e.g. by splitting the products of a rare process) are culled and the
+ * survivors carry their weight.
+ *
+ * Each window is configured with
+ * - max_energy : upper edge of the energy band [MeV]
+ * - lower_weight : tracks below this weight play russian roulette
+ * - upper_weight : tracks above this weight are split
+ * - survival_weight : weight of the survivors of the roulette
+ *   (default the geometric mean of the bounds)
+ *
+ * Tracks above the highest band are left alone. Since the operator does
+ * not bias a process, it can act on several particles at once.
+ *
+ * The event weight is left alone, the split and roulette weights are only
+ * carried by the hits (calorimeter hit contributions) of the tracks. Any
+ * weight a track got upstream from biasing its occurence is already in
+ * the event weight and is not part of the hit weight, so analyses weight
+ * each hit by the event weight times the hit weight.
+ */
+class WeightWindow : public XsecBiasingOperator {
+ public:
+  /**
+   * Constructor
+   *
+   * Calls parent constructor and allows
+   * accesss to configuration parameters.
+   */
+  WeightWindow(std::string name, const fire::config::Parameters& p);
+
+  /** Destructor */
+  ~WeightWindow() = default;
+
+  /** Method called at the beginning of a run. */
+  void StartRun();
+
+  /// Do not bias the occurence of any process
+  G4VBiasingOperation* ProposeOccurenceBiasingOperation(
+      const G4Track*, const G4BiasingProcessInterface*) final override {
+    return 0;
+  }
+
+  /// There is no process to bias
+  virtual std::string getProcessToBias() const { return ""; }
+
+  /// Return the first particle to bias
+  virtual std::string getParticleToBias() const { return particles_.front(); }
+
+  /// Return all the particles to bias
+  virtual std::vector<std::string> getParticlesToBias() const {
+    return particles_;
+  }
+
+  /// Return the volume to bias in
+  virtual std::string getVolumeToBias() const { return volume_; }
+
+  /**
+   * Record the configuration to the run header
+   *
+   * @param[in,out] header RunHeader to record to
+   */
+  virtual void RecordConfig(fire::RunHeader& header) const;
+
+ protected:
+  /**
+   * Propose to bring the weight of the track back into its window.
+   *
+   * @param track handle to the track being stepped
+   * @return the weight window operation if the track is out of its window
+   */
+  G4VBiasingOperation* ProposeNonPhysicsBiasingOperation(
+      const G4Track* track, const G4BiasingProcessInterface*) final override;
+
+ private:
+  /// The operation splitting and killing tracks
+  WeightWindowOperation* window_operation_{nullptr};
+
+  /// The volume to bias in
+  std::string volume_;
+
+  /// The particles to bias
+  std::vector<std::string> particles_;
+
+  /// The windows, sorted by energy band
+  std::vector<Window> windows_;
+
+  /// Maximum number of copies to split a track into
+  int max_split_;
+};  // WeightWindow
+
+}  // namespace biasoperators
+}  // namespace g4fire
+
+#endif  // G4FIRE_BIASOPERATORS_WEIGHTWINDOW_H_
@@ -8,6 +8,7 @@
 #include "DetDescr/DetectorID.h"
 #include "Framework/Event.h"
 #include "g4fire/G4CalorimeterHit.h"
+#include "g4fire/ReadoutFilter.h"
 
 using ldmx::DetectorID;
 
@@ -16,8 +17,13 @@ namespace g4fire {
 /**
  * @class CalorimeterSD
  * @brief Basic calorimeter sensitive detector
+ *
+ * @note
+ * Derived classes should reject steps outside of the readout window
+ * in ProcessHits. The zero-suppression threshold is applied to the
+ * hits collection at the end of the event.
  */
-class CalorimeterSD : public G4VSensitiveDetector {
+class CalorimeterSD : public G4VSensitiveDetector, public ReadoutFilter {
  public:
   /**
    * Class constructor.
@@ -0,0 +1,126 @@
+#ifndef G4FIRE_CROSSINGFILTER_H
+#define G4FIRE_CROSSINGFILTER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+#include "G4Step.hh"
+#include "G4ThreeVector.hh"
+#include "G4Track.hh"
+
+namespace g4fire {
+
+/**
+ * Selection of the particles recorded by a scoring plane.
+ *
+ * Particles can be selected by their PDG ID and by a minimum momentum.
+ * In addition, the recorded crossings can be deduplicated so that
+ * only the first step of a track through a plane is recorded, instead
+ * of every step it takes inside of the plane.
+ *
+ * Scoring plane sensitive detectors inherit from this class in order
+ * to be configurable. By default, every step of every particle is
+ * recorded. They also implement recordCrossing so that crossings found
+ * outside of Geant4's sensitive detector machinery (e.g. analytically
+ * in the stepping action) end up in their hits collection.
+ */
+class CrossingFilter {
+ public:
+  /// Destructor
+  virtual ~CrossingFilter() = default;
+
+  /**
+   * Only record the first crossing of a track through a plane.
+   *
+   * @param[in] yes true to deduplicate the crossings
+   */
+  void setFirstCrossingOnly(bool yes) { first_crossing_only_ = yes; }
+
+  /**
+   * @return true if only the first crossing of a track is recorded
+   */
+  bool isFirstCrossingOnly() const { return first_crossing_only_; }
+
+  /**
+   * Only record particles with one of the input PDG IDs.
+   *
+   * @param[in] pdg_ids PDG IDs to record, all particles are recorded
+   *  if this is empty
+   */
+  void setPdgIDs(const std::vector<int> &pdg_ids) { pdg_ids_ = pdg_ids; }
+
+  /**
+   * Only record particles above the input momentum.
+   *
+   * @param[in] min_momentum minimum momentum to record [MeV]
+   */
+  void setMinMomentum(double min_momentum) { min_momentum_ = min_momentum; }
+
+  /**
+   * Record a crossing of a plane found during the input step.
+   *
+   * The crossing is subject to the same selection as the ones found
+   * by the sensitive detector itself.
+   *
+   * @param[in] step step during which the plane was crossed
+   * @param[in] position position of the crossing
+   * @param[in] fraction fraction of the step before the crossing, used
+   *  to interpolate the time and momentum at the crossing
+   * @param[in] plane copy number of the crossed plane
+   */
+  virtual void recordCrossing(const G4Step *step,
+                              const G4ThreeVector &position, double fraction,
+                              int plane) = 0;
+
+ protected:
+  /**
+   * Check if a crossing of a track through a plane should be recorded.
+   *
+   * If the crossing is accepted and only the first crossing is recorded,
+   * this track is remembered so later steps through the same plane
+   * are rejected.
+   *
+   * @param[in] track track crossing the plane
+   * @param[in] momentum magnitude of the momentum at the crossing [MeV]
+   * @param[in] plane copy number of the plane
+   * @return true if the crossing should be recorded
+   */
+  bool acceptCrossing(const G4Track *track, double momentum, int plane) {
+    if (momentum < min_momentum_) return false;
+
+    if (!pdg_ids_.empty() and
+        std::find(pdg_ids_.begin(), pdg_ids_.end(),
+                  track->GetDefinition()->GetPDGEncoding()) == pdg_ids_.end())
+      return false;
+
+    if (first_crossing_only_) {
+      uint64_t key{(uint64_t(uint32_t(track->GetTrackID())) << 32) |
+                   uint32_t(plane)};
+      return crossings_.insert(key).second;
+    }
+
+    return true;
+  }
+
+  /// Forget the crossings recorded in the previous event
+  void clearCrossings() { crossings_.clear(); }
+
+ private:
+  /// Only record the first crossing of a track through a plane
+  bool first_crossing_only_{false};
+
+  /// PDG IDs to record, empty means all
+  std::vector<int> pdg_ids_;
+
+  /// Minimum momentum to record [MeV]
+  double min_momentum_{0.};
+
+  /// Track ID and plane pairs that already crossed in this event
+  std::unordered_set<uint64_t> crossings_;
+};
+
+}  // namespace g4fire
+
+#endif  // G4FIRE_CROSSINGFILTER_H
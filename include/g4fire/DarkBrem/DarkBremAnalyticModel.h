@@ -0,0 +1,196 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "fire/config/Parameters.h"
+#include "g4fire/DarkBrem/G4eDarkBremsstrahlung.h"
+
+namespace g4fire {
+namespace darkbrem {
+
+/**
+ * @class DarkBremAnalyticModel
+ *
+ * Geant4 implementation of the model for a particle undergoing a dark brem
+ * where the outgoing kinematics are sampled from the Weizsacker-Williams
+ * differential cross section instead of an imported vertex library.
+ *
+ * With \f$x = E_A/E_0\f$ and \f$y = E_0^2x\theta_A^2\f$, the differential
+ * cross section is (Bjorken et al, PRD 80, 075018, eq. A12)
+ *
+ * \f[ \frac{d\sigma}{dx\,dy} \propto \frac{1-x+x^2/2}{U^2}
+ *     - \frac{x(1-x)m_A^2(y+m_e^2x)}{U^4} \f]
+ *
+ * \f[ U = y + c(x), \quad c(x) = m_A^2\frac{1-x}{x} + m_e^2x \f]
+ *
+ * The marginal distribution in x does not depend on the incident energy,
+ * only its upper limit does, so a single inverse-CDF table in
+ * \f$-\ln(1-x)\f$ serves all energies. The distribution in the angle for a
+ * given x is a cubic polynomial in \f$w = y/(y+c)\f$ whose CDF is inverted
+ * exactly. Since nothing depends on a MadGraph library, any A' mass can be
+ * simulated without generating or loading one.
+ *
+ * This model depends on several configurable parameters.
+ *
+ * - epsilon : strength of the dark photon - photon mixing
+ * - threshold : minimum energy in GeV for the electron to have a non-zero
+ *   cross section for going dark brem
+ * - num_x_bins : number of bins of the x table (default 1000)
+ * - max_energy : maximum incident energy of the x table in GeV, above it
+ *   the x distribution is truncated (default 1000)
+ * - table_file : file to cache the x table in (default none), it is read
+ *   if it matches the configuration and written otherwise
+ */
+class DarkBremAnalyticModel : public G4eDarkBremsstrahlungModel {
+public:
+  /**
+   * Constructor
+   * Set the parameters for this model and build (or load) the x table.
+   *
+   * The threshold is set to the maximum of the passed value or twice
+   * the A' mass (so that it kinematically makes sense).
+   */
+  DarkBremAnalyticModel(fire::config::Parameters &params);
+
+  /**
+   * Destructor
+   */
+  virtual ~DarkBremAnalyticModel() {}
+
+  /**
+   * Print the configuration of this model
+   */
+  virtual void PrintInfo() const;
+
+  /**
+   * Record the configuration of this model into the RunHeader
+   */
+  virtual void RecordConfig(fire::RunHeader &h) const;
+
+  /**
+   * The cross section only depends on the threshold and epsilon.
+   */
+  virtual std::string CacheKey() const;
+
+  /**
+   * @returns the threshold in Geant4 units
+   */
+  virtual G4double GetThreshold() const;
+
+  /**
+   * Calculates the cross section per atom in GEANT4 internal units.
+   *
+   * @see ww::CrossSectionPerAtom
+   * @param electron_ke kinetic energy of the incoming electron
+   * @param A atomic mass of atom
+   * @param Z atomic number of atom
+   * @return cross section (0. if below the threshold)
+   */
+  virtual G4double ComputeCrossSectionPerAtom(G4double electron_ke,
+                                              G4double atomic_a,
+                                              G4double atomic_z);
+
+  /**
+   * Calculates the cross section per atom for another A' mass.
+   *
+   * The threshold is raised to twice that mass if it is larger.
+   */
+  virtual G4double ComputeCrossSectionPerAtomAtMass(G4double electron_ke,
+                                                    G4double atomic_a,
+                                                    G4double atomic_z,
+                                                    G4double ap_mass);
+
+  /**
+   * Sample x and the angle of the A' and put the A' and the recoil electron
+   * into the particle change.
+   *
+   * The A' is given the energy \f$xE_0\f$, the recoil electron takes the
+   * rest of the energy and the transverse momentum of the A'. The recoil of
+   * the nucleus is neglected, as in the WW approximation.
+   *
+   * @param[in,out] particle_change the particle change to fill
+   * @param[in] track the incident electron
+   * @param[in] step the step of the dark brem
+   */
+  virtual void GenerateChange(G4ParticleChange &particle_change,
+                              const G4Track &track, const G4Step &step);
+
+private:
+  /// Build the inverse-CDF table in x
+  void BuildTable();
+
+  /**
+   * Read the table from table_file_
+   *
+   * @return false if there is no file or it doesn't match the configuration
+   */
+  bool LoadTable();
+
+  /// Write the table to table_file_
+  void SaveTable() const;
+
+  /**
+   * Interpolate the CDF table
+   *
+   * @param[in] z \f$-\ln(1-x)\f$
+   * @return fraction of the cross section below z
+   */
+  double CDF(double z) const;
+
+  /**
+   * Sample the fraction of the incident energy carried by the A'
+   *
+   * @param[in] E0 energy of the incident electron [GeV]
+   * @return x
+   */
+  double SampleX(double E0) const;
+
+  /**
+   * Sample the angle variable for a given x
+   *
+   * @param[in] x fraction of the incident energy carried by the A'
+   * @param[in] w_max upper limit on w from the maximum angle
+   * @return \f$w = y/(y+c(x))\f$
+   */
+  double SampleW(double x, double w_max) const;
+
+  /** Threshold for non-zero xsec [GeV]
+   *
+   * Configurable with 'threshold'
+   */
+  double threshold_;
+
+  /** Epsilon value to plug into xsec calculation
+   *
+   * @sa ComputeCrossSectionPerAtom for how this is used
+   *
+   * Configurable with 'epsilon'
+   */
+  double epsilon_;
+
+  /// Number of bins of the x table
+  int num_x_bins_;
+
+  /// Maximum incident energy covered by the x table [GeV]
+  double max_energy_;
+
+  /// File to cache the x table in, empty for no cache
+  std::string table_file_;
+
+  /// Upper edge of the x table in \f$-\ln(1-x)\f$
+  double z_max_;
+
+  /// CDF at the edges of the bins of the x table, uniform in \f$-\ln(1-x)\f$
+  std::vector<double> cdf_;
+
+  /**
+   * Should we always create a totally new electron when we dark brem?
+   *
+   * @see DarkBremVertexLibraryModel::always_create_new_electron_
+   */
+  bool always_create_new_electron_{true};
+};
+
+} // namespace darkbrem
+} // namespace g4fire
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <memory>
+
 #include <Eigen/Dense>
 
 #include "fire/config/Parameters.h"
 #include "g4fire/DarkBrem/G4eDarkBremsstrahlung.h"
+#include "g4fire/DarkBrem/VertexLibrary.h"
 
 namespace g4fire {
 
@@ -22,7 +25,9 @@ namespace darkbrem {
  * on severl configurable parameters.
  *
  * - library_path : the full path to the directory containing the LHE dark brem
- *   vertices that will be read in to make the vertex library
+ *   vertices that will be read in to make the vertex library, to a binary
+ *   vertex library or to an indexed store of binary libraries for several
+ *   masses (see VertexLibrary)
  * - epsilon : strength of the dark photon - photon mixing
  * - threshold : minimum energy in GeV for the electron to have a non-zero
  *   cross section for going dark brem
@@ -47,7 +52,8 @@ public:
    * The threshold is set to the maximum of the passed value or twice
    * the A' mass (so that it kinematically makes sense).
    *
-   * The library path is immediately passed to SetMadGraphDataLibrary.
+   * The library path is checked immediately but the library is only
+   * loaded when the first dark brem occurs.
    */
   DarkBremVertexLibraryModel(fire::config::Parameters &params);
 
@@ -66,21 +72,22 @@ public:
    */
   virtual void RecordConfig(fire::RunHeader &h) const;
 
+  /**
+   * The cross section only depends on the threshold and epsilon, the
+   * vertex library and the scaling method only change the kinematics.
+   */
+  virtual std::string CacheKey() const;
+
+  /**
+   * @returns the threshold in Geant4 units
+   */
+  virtual G4double GetThreshold() const;
+
   /**
    * Calculates the cross section per atom in GEANT4 internal units.
-   * Uses WW approximation to find the total cross section, performing numerical
-   * integrals over x and theta.
-   *
-   * Numerical integrals are done using boost::numeric::odeint.
-   *
-   * Integrate Chi from \f$m_A^4/(4E_0^2)\f$ to \f$m_A^2\f$
-   *
-   * Integrate DiffCross from 0 to \f$min(1-m_e/E_0,1-m_A/E_0)\f$
-   *
-   * Total cross section is given by
-   * \f[ \sigma = 4 \frac{pb}{GeV} \epsilon^2 \alpha_{EW}^3 \int \chi(t)dt \int
-   * \frac{d\sigma}{dx}(x)dx \f]
+   * Uses WW approximation to find the total cross section.
    *
+   * @see ww::CrossSectionPerAtom
    * @param E0 energy of beam (incoming particle)
    * @param Z atomic number of atom
    * @param A atomic mass of atom
@@ -91,6 +98,16 @@ public:
                                               G4double atomic_a,
                                               G4double atomic_z);
 
+  /**
+   * Calculates the cross section per atom for another A' mass.
+   *
+   * The threshold is raised to twice that mass if it is larger.
+   */
+  virtual G4double ComputeCrossSectionPerAtomAtMass(G4double electron_ke,
+                                                    G4double atomic_a,
+                                                    G4double atomic_z,
+                                                    G4double ap_mass);
+
   /**
    * Simulates the emission of a dark photon + electron.
    *
@@ -100,9 +117,9 @@ public:
    *
    * ## Forward Only
    * Scales the energy so that the fraction of kinectic energy is constant,
-   * keeps the Pt constant. If the Pt is larger than the new energy, that event
-   * is skipped, and a new one is taken from the file. Choses the Pz of the
-   * recoil electron to always be positive.
+   * keeps the Pt constant. Only events whose Pt is smaller than the new
+   * energy are sampled (see PrepareLibrary), so no event is ever skipped.
+   * Choses the Pz of the recoil electron to always be positive.
    *
    * ## CM Scaling
    * Scale MadGraph vertex to actual energy of electron using Lorentz boosts,
@@ -120,93 +137,6 @@ public:
                               const G4Track &track, const G4Step &step);
 
 private:
-  /**
-   * Set the library of dark brem events to be scaled.
-   * @param file path to directory of LHE files
-   */
-  void SetMadGraphDataLibrary(std::string path);
-
-  /**
-   * Helpful typedef for boost integration.
-   */
-  typedef std::vector<double> StateType;
-
-  /**
-   * @struct Chi
-   *
-   * Stores parameters for chi function used in integration.
-   * Implements function as member operator compatible with
-   * boost::numeric::odeint
-   *
-   * \f[ \chi(t) = \left(
-   * \frac{Z^2a^4t^2}{(1+a^2t)^2(1+t/d)^2}+\frac{Za_p^4t^2}{(1+a_p^2t)^2(1+t/0.71)^8}\left(\frac{1+t(m_{up}^2-1)}{4m_p^2}\right)^2\right)\frac{t-m_A^4/(4E_0^2)}{t^2}
-   * \f]
-   *
-   * where
-   * \f$m_A\f$ = mass of A' in GeV,
-   * \f$m_e\f$ = mass of electron in GeV,
-   * \f$E_0\f$ = incoming energy of electron in GeV,
-   * \f$A\f$ = atomic number of target atom,
-   * \f$Z\f$ = atomic mass of target atom,
-   * \f[a = \frac{111.0}{m_e Z^{1/3}}\f]
-   * \f[a_p = \frac{773.0}{m_e Z^{2/3}}\f]
-   * \f[d = \frac{0.164}{A^{2/3}}\f]
-   * \f$m_{up}\f$ = mass of up quark, and
-   * \f$m_{p}\f$ = mass of proton
-   */
-  struct Chi {
-    /// atomic number
-    double A;
-    /// atomic mass
-    double Z;
-    /// incoming beam energy [GeV]
-    double E0;
-    /// A' mass [GeV]
-    double MA;
-    /// electron mass [GeV]
-    double Mel;
-
-    /**
-     * Access function in style required by boost::numeric::odeint
-     *
-     * Calculates dxdt from t and other paramters.
-     */
-    void operator()(const StateType &, StateType &dxdt, double t);
-  };
-
-  /**
-   * @struct DiffCross
-   *
-   * Implementation of the differential scattering cross section.
-   * Stores parameters.
-   *
-   * Implements function as member operator compatible with
-   * boost::numeric::odeint
-   *
-   * \f[ \frac{d\sigma}{dx}(x) =
-   * \sqrt{1-\frac{m_A^2}{E_0^2}}\frac{1-x+x^2/3}{m_A^2(1-x)/x+m_e^2x} \f]
-   *
-   * where
-   * \f$m_A\f$ = mass of A' in GeV
-   * \f$m_e\f$ = mass of electron in GeV
-   * \f$E_0\f$ = incoming energy of electron in GeV
-   */
-  struct DiffCross {
-    /// incoming beam energy [GeV]
-    double E0;
-    /// A' mass [GeV]
-    double MA;
-    /// electron mass [GeV]
-    double Mel;
-
-    /**
-     * Access function in style required by boost::numeric::odeint
-     *
-     * Calculates dsigma_dx from x and other paramters.
-     */
-    void operator()(const StateType &, StateType &dsigma_dx, double x);
-  };
-
   /**
    * @struct OutgoingKinematics
    *
@@ -224,29 +154,32 @@ private:
     G4double E;
   };
 
-  /*
-   * Parse an LHE File
-   *
-   * Parses an LHE file to extract the kinetic energy fraction and pt of the
-   * outgoing electron in each event. Loads the two numbers from every event
-   * into a map of vectors of pairs (mgdata). Map is keyed by energy, vector
-   * pairs are energy fraction + pt. Also creates an list of energies and
-   * placeholders (energies), so that different energies can be looped
-   * separately.
-   *
-   * @param fname name of LHE file to parse
-   */
-  void ParseLHE(std::string fname);
-
   /**
    * Fill vector of current_data_points_ with the same number of items as the
-   * madgraph data.
+   * energy bins of the vertex library.
    *
    * Randomly choose a starting point so that the simulation run isn't dependent
    * on the order of LHE vertices in the library.
    */
   void MakePlaceholders();
 
+  /**
+   * Prepare the loaded library for sampling.
+   *
+   * The bin energies are copied into a sorted array for binary search.
+   *
+   * For the forward_only method, the minimum incident energy at which each
+   * event stays kinematically valid after scaling (pt^2 + m_e^2 <= E_acc^2)
+   * is computed. Since E_acc grows with the incident energy, this is
+   *
+   * \f[ E_{min} = m_e + m_A + (\sqrt{p_T^2+m_e^2}-m_e)
+   *     \frac{E_{bin}-m_e-m_A}{E_e-m_e} \f]
+   *
+   * and the events of each bin are ordered by it, so the events valid at
+   * any incident energy are a prefix of the bin.
+   */
+  void PrepareLibrary();
+
   /**
    * Returns mad graph data given an energy [GeV].
    *
@@ -255,11 +188,26 @@ private:
    * Scales from the closest imported beam energy above the given value (scales
    * down to avoid biasing issues).
    *
+   * For the forward_only method, the event is sampled uniformly from the
+   * events that are valid at E0. If there are none, the closest bin below
+   * E0 with valid events is used instead. If no bin has any, a warning is
+   * printed and the event closest to being valid is used.
+   *
    * @param E0 energy of particle undergoing dark brem [GeV]
    * @return total energy and transverse momentum of particle [GeV]
    */
   OutgoingKinematics GetMadgraphData(double E0);
 
+  /**
+   * Count the events of a bin that are valid at an incident energy
+   * in the forward_only method.
+   *
+   * @param i_bin index of the bin
+   * @param E0 energy of particle undergoing dark brem [GeV]
+   * @return number of valid events, they are the first ones in valid_order_
+   */
+  std::size_t CountValidEvents(std::size_t i_bin, double E0) const;
+
 private:
   // TODO(OM) Move these methods to utility classes.
   /**
@@ -312,13 +260,6 @@ private:
 
   }
 
-  /**
-   * maximum number of iterations to check before giving up on an event
-   *
-   * @TODO make configurable and/or optimize somehow
-   */
-  unsigned int max_iterations_{10000};
-
   /** Threshold for non-zero xsec [GeV]
    *
    * Configurable with 'threshold'
@@ -376,26 +317,40 @@ private:
   bool always_create_new_electron_{true};
 
   /**
-   * Storage of data from mad graph
+   * Library of dark brem vertices from mad graph
    *
-   * Maps incoming electron energy to various options for outgoing kinematics.
-   * This is a hefty map and is what stores **all** of the vertices
-   * imported from the LHE library of dark brem vertices.
+   * Holds the vertices binned by incoming electron energy, sorted by
+   * that energy. This is what stores **all** of the vertices imported
+   * from the library of dark brem vertices.
    *
-   * Library is read in from configuration parameter 'darkbrem.madgraphlibrary'
+   * Library is read in from configuration parameter 'library_path'
    */
-  std::map<double, std::vector<OutgoingKinematics>> mad_graph_data_;
+  std::unique_ptr<VertexLibrary> library_;
 
   /**
-   * Stores a map of current access points to mad graph data.
-   *
-   * Maps incoming electron energy to the index of the data vector
-   * that we will get the data from.
+   * Stores the current access points to the vertex library.
    *
-   * Also sorts the incoming electron energy so that we can find
-   * the sampling energy that is closest above the actual incoming energy.
+   * Holds the index of the vertex within each energy bin of the
+   * library that we will get the data from next. Empty until the
+   * first dark brem.
+   */
+  std::vector<unsigned int> current_data_points_;
+
+  /// Energies of the bins of the vertex library, sorted [GeV]
+  std::vector<double> bin_energies_;
+
+  /**
+   * Minimum incident energy for each event to be valid in forward_only
+   * mode [GeV], sorted within each bin. Laid out like the vertices of
+   * the library.
    */
-  std::map<double, unsigned int> current_data_points_;
+  std::vector<double> min_energies_;
+
+  /// Index of the event (within its bin) of each entry of min_energies_
+  std::vector<uint32_t> valid_order_;
+
+  /// Index of the first entry of each bin in min_energies_
+  std::vector<std::size_t> min_energy_offsets_;
 };
 
 } // namespace darkbrem
@@ -7,6 +7,8 @@
 
 #include "G4VDiscreteProcess.hh"
 
+#include "G4PhysicsLogVector.hh"
+
 class G4String;
 class G4ParticleDefinition;
 
@@ -55,6 +57,28 @@ class G4eDarkBremsstrahlungModel {
    */
   virtual void RecordConfig(fire::RunHeader& h) const = 0;
 
+  /**
+   * Name this model and the configuration of it that changes the cross
+   * section.
+   *
+   * The key is part of the name of the on-disk cross section cache, so
+   * two configurations may only share a key if they have the same cross
+   * sections. It should only contain characters valid in a file name.
+   *
+   * @returns key for the cross sections of this model
+   */
+  virtual std::string CacheKey() const = 0;
+
+  /**
+   * Get the minimum kinetic energy of an electron to dark brem
+   *
+   * The cross section is zero below this energy, so the mean free path
+   * tables start there.
+   *
+   * @returns threshold with units incorporated as a G4double
+   */
+  virtual G4double GetThreshold() const = 0;
+
   /**
    * Calculate the cross section given the input parameters
    *
@@ -68,6 +92,23 @@ class G4eDarkBremsstrahlungModel {
                                               G4double atomic_a,
                                               G4double atomic_z) = 0;
 
+  /**
+   * Calculate the cross section for an A' mass other than the simulated one
+   *
+   * This is used to reweight events to other masses, so it must be
+   * consistent with ComputeCrossSectionPerAtom.
+   *
+   * @param[in] electron_ke current electron kinetic energy
+   * @param[in] atomic_a atomic-mass number for the element the electron is in
+   * @param[in] atomic_z atomic-number for the element the electron is in
+   * @param[in] ap_mass mass of the A' with units incorporated
+   * @returns cross section with units incorporated as a G4double
+   */
+  virtual G4double ComputeCrossSectionPerAtomAtMass(G4double electron_ke,
+                                                    G4double atomic_a,
+                                                    G4double atomic_z,
+                                                    G4double ap_mass) = 0;
+
   /**
    * Generate the change in the particle now that we can assume the interaction
    * is occuring
@@ -108,9 +149,14 @@ class ElementXsecCache {
 
   /**
    * Constructor with a model to calculate the cross section.
+   *
+   * @param[in] model model to calculate cross sections with
+   * @param[in] ap_mass A' mass to calculate the cross sections for, the
+   *  simulated mass if not positive
    */
-  ElementXsecCache(std::shared_ptr<G4eDarkBremsstrahlungModel> model)
-      : model_{model} {}
+  ElementXsecCache(std::shared_ptr<G4eDarkBremsstrahlungModel> model,
+                   G4double ap_mass = -1.)
+      : model_{model}, ap_mass_{ap_mass} {}
 
   /**
    * Get the value of the cross section for the input variables
@@ -125,6 +171,31 @@ class ElementXsecCache {
    */
   G4double get(G4double energy, G4double A, G4double Z);
 
+  /**
+   * Load cross sections from a file written by save.
+   *
+   * Cross sections already in the cache are kept. A file that doesn't exist
+   * or can't be parsed is ignored, the cross sections are then calculated
+   * as they are needed.
+   *
+   * @param[in] file_name path to the cache file
+   * @returns number of cross sections loaded from the file
+   */
+  std::size_t load(const std::string& file_name);
+
+  /**
+   * Write the cache to a file if cross sections were calculated since
+   * it was constructed or loaded.
+   *
+   * Jobs sharing the cache take turns through a lock file next to it. While
+   * holding the lock, the cross sections saved by other jobs in the meantime
+   * are merged in. The table is then written to a temporary file, which is
+   * renamed, so jobs sharing the cache never read a partial file.
+   *
+   * @param[in] file_name path to the cache file
+   */
+  void save(const std::string& file_name);
+
   /**
    * Stream the entire table into the output stream.
    *
@@ -175,9 +246,15 @@ class ElementXsecCache {
   /// the actual map from cache keys to calculated cross sections
   std::map<key_t, G4double> the_cache_;
 
+  /// have cross sections been calculated that aren't saved?
+  bool modified_{false};
+
   /// shared pointer to the model for calculating cross sections
   std::shared_ptr<G4eDarkBremsstrahlungModel> model_;
 
+  /// A' mass of the cross sections, the simulated mass if not positive
+  G4double ap_mass_{-1.};
+
 };  // ElementXsecCache
 
 /**
@@ -218,13 +295,20 @@ class G4eDarkBremsstrahlung : public G4VDiscreteProcess {
    * common cross sections immediately to help even out the time
    * it takes to simulate events.
    * @see CalculateCommonXsec
+   *
+   * If a directory for the cache is given with 'xsec_cache_dir', the
+   * cache is loaded from the file for this A' mass and model instead and
+   * only the missing cross sections are calculated when they are needed.
    */
   G4eDarkBremsstrahlung(const fire::config::Parameters& params);
 
   /**
    * Destructor
+   *
+   * Writes the cross sections calculated during the run back to the
+   * on-disk cache, if there is one.
    */
-  virtual ~G4eDarkBremsstrahlung() = default;
+  virtual ~G4eDarkBremsstrahlung();
 
   /**
    * Checks if the passed particle should be able to do this process
@@ -259,6 +343,9 @@ class G4eDarkBremsstrahlung : public G4VDiscreteProcess {
    * ensuring only one dark brem per step and per event.
    * Reactivated in RunManager::TerminateOneEvent.
    *
+   * If masses to reweight to are configured, the dark brem is recorded
+   * in the UserEventInformation with its weights for those masses.
+   *
    * @see RunManager::TerminateOneEvent
    * @see G4eDarkBremsstrahlungModel::GenerateChange
    * @param[in] track current G4Track that is being stepped
@@ -268,6 +355,23 @@ class G4eDarkBremsstrahlung : public G4VDiscreteProcess {
   virtual G4VParticleChange* PostStepDoIt(const G4Track& track,
                                           const G4Step& step);
 
+  /**
+   * Build the tables of the cross section per volume of the materials
+   * used in the geometry.
+   *
+   * The tables are binned logarithmically in the kinetic energy of the
+   * electron from the threshold of the model up to 'xsec_table_max_energy'
+   * with 'xsec_table_bins_per_decade' bins per decade. The cross sections
+   * of the elements are taken from the cache if caching is enabled.
+   *
+   * If only one dark brem per event is allowed, this process and its
+   * biasing wrapper are resolved in the ProcessActivationManager here since
+   * all processes are attached to the electron by now.
+   *
+   * @param[in] particle the electron
+   */
+  virtual void BuildPhysicsTable(const G4ParticleDefinition& particle);
+
   /**
    * Calculate common cross sections for the cache using the already-created
    * model.
@@ -286,15 +390,26 @@ class G4eDarkBremsstrahlung : public G4VDiscreteProcess {
    */
   ElementXsecCache& getCache() { return element_xsec_cache_; }
 
+  /**
+   * @returns the A' masses [MeV] events are reweighted to, empty if none
+   */
+  const std::vector<double>& getReweightMasses() const {
+    return reweight_masses_;
+  }
+
  protected:
   /**
    * Calculate the mean free path given the input conditions
    *
+   * The cross section per volume is interpolated from the table of the
+   * material built in BuildPhysicsTable. Only materials without a table
+   * and energies above the tables sum the cross sections of the elements.
+   *
    * We maintain a cache for the cross sections calculated by the model
-   * so that later in the run it is less likely that the model will
-   * need to be called to calculate the cross section. This is done
-   * in order to attempt to improve speed of simulation and avoid
-   * repetition of the same, deterministic calculations.
+   * so that it is less likely that the model will need to be called to
+   * calculate the cross section. This is done in order to attempt to
+   * improve speed of simulation and avoid repetition of the same,
+   * deterministic calculations.
    *
    * If you want to turn off the cache-ing behavior, set 'cache_xsec' to false
    * in the python configuratin for the dark brem process.
@@ -309,6 +424,41 @@ class G4eDarkBremsstrahlung : public G4VDiscreteProcess {
   G4double GetMeanFreePath(const G4Track& track, G4double prevStepSize,
                            G4ForceCondition* condition);
 
+  /**
+   * Sum the cross sections of the elements of a material
+   *
+   * @param[in] material material the electron is in
+   * @param[in] energy kinetic energy of the electron
+   * @returns cross section per volume of the material
+   */
+  G4double ComputeCrossSectionPerVolume(const G4Material* material,
+                                        G4double energy);
+
+  /**
+   * Get the cross section of an element at the simulated mass, from the
+   * cache if caching is enabled.
+   *
+   * @param[in] energy kinetic energy of the electron
+   * @param[in] A atomic mass of the element
+   * @param[in] Z atomic number of the element
+   * @returns cross section per atom
+   */
+  G4double GetElementXsec(G4double energy, G4double A, G4double Z);
+
+  /**
+   * Choose the element of the material the dark brem happened on and
+   * record the dark brem with its weights for the other masses.
+   *
+   * The element is chosen with a probability proportional to its
+   * contribution to the cross section of the material. The weight for
+   * each mass is the ratio of its cross section on that element to the
+   * simulated one.
+   *
+   * @param[in] track the incident electron
+   * @param[in] aprime_energy total energy of the produced A'
+   */
+  void RecordForReweighting(const G4Track& track, G4double aprime_energy);
+
  private:
   /** remove ability to assign this object */
   G4eDarkBremsstrahlung& operator=(const G4eDarkBremsstrahlung& right);
@@ -322,9 +472,11 @@ class G4eDarkBremsstrahlung : public G4VDiscreteProcess {
    * This allows for the dark brem process to be de-activated when
    * SampleSecondaries is called.
    *
-   * The dark brem process is _always_ re-activated in the
-   * RunManager::TerminateOneEvent method. This reactivation has no effect when
-   * the process is already active.
+   * The process and its biasing wrapper are resolved once in
+   * BuildPhysicsTable and are re-activated in the
+   * RunManager::TerminateOneEvent method if they were deactivated.
+   *
+   * @see ProcessActivationManager
    */
   bool only_one_per_event_;
 
@@ -338,6 +490,14 @@ class G4eDarkBremsstrahlung : public G4VDiscreteProcess {
    */
   bool cache_xsec_;
 
+  /**
+   * File the cache is loaded from and saved to, empty if the cache is
+   * only kept in memory.
+   *
+   * The name is made from the A' mass and the CacheKey of the model.
+   */
+  std::string xsec_cache_file_;
+
   /**
    * The model that we are using in this run.
    *
@@ -348,6 +508,30 @@ class G4eDarkBremsstrahlung : public G4VDiscreteProcess {
   /// Our instance of a cross section cache
   ElementXsecCache element_xsec_cache_;
 
+  /**
+   * Other A' masses to calculate event weights for [MeV]
+   *
+   * Configurable with 'reweight_masses', empty to not reweight.
+   * Every event header then holds dark_brem_weight_<mass>MeV for each
+   * mass, the dark_brem_count and the dark_brem_<i>_* kinematics.
+   */
+  std::vector<double> reweight_masses_;
+
+  /// Cache of the cross sections for each mass to reweight to
+  std::vector<ElementXsecCache> reweight_caches_;
+
+  /// Maximum kinetic energy of the cross section tables [MeV]
+  double xsec_table_max_energy_;
+
+  /// Number of bins per decade of the cross section tables
+  int xsec_table_bins_per_decade_;
+
+  /**
+   * Cross section per volume of each material, indexed by the index of the
+   * material. Materials without a production cuts couple have no table.
+   */
+  std::vector<std::unique_ptr<G4PhysicsLogVector>> xsec_tables_;
+
   /// Enable logging for this process
   //fire::logging::logger theLog_ =
   //    fire::logging::makeLogger("DarkBremProcess");
@@ -0,0 +1,133 @@
+#ifndef G4FIRE_DARKBREM_GAUSSKRONROD_H
+#define G4FIRE_DARKBREM_GAUSSKRONROD_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace g4fire {
+namespace darkbrem {
+namespace gausskronrod {
+
+/**
+ * @struct Segment
+ *
+ * A sub-interval of the integration range and its estimates.
+ */
+struct Segment {
+  /// lower edge
+  double a;
+  /// upper edge
+  double b;
+  /// 15-point Kronrod estimate of the integral over the segment
+  double result;
+  /// difference between the Kronrod and 7-point Gauss estimates
+  double error;
+};
+
+/**
+ * Integrate over a segment with the 15-point Kronrod rule and the 7-point
+ * Gauss rule embedded in it.
+ *
+ * The 15 integrand values are computed first and then summed, so the
+ * evaluations are independent of each other and the compiler is free to
+ * interleave them.
+ *
+ * @param[in] f integrand
+ * @param[in] a lower edge
+ * @param[in] b upper edge
+ * @returns the segment with its estimates
+ */
+template <typename Function>
+Segment rule(const Function &f, double a, double b) {
+  // abscissae of the Kronrod rule, the odd ones are the Gauss abscissae
+  static const double xgk[8] = {
+      0.991455371120812639206854697526329, 0.949107912342758524526189684047851,
+      0.864864423359769072789712788640926, 0.741531185599394439863864773280788,
+      0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+      0.207784955007898467600689403773245, 0.000000000000000000000000000000000};
+  static const double wgk[8] = {
+      0.022935322010529224963732008058970, 0.063092092629978553290700663189204,
+      0.104790010322250183839876322541518, 0.140653259715525918745189590510238,
+      0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+      0.204432940075298892414161999234649, 0.209482141084727828012999174891714};
+  static const double wg[4] = {
+      0.129484966168869693270611432679082, 0.279705391489276667901467771423780,
+      0.381830050505118944950369775488975, 0.417959183673469387755102040816327};
+
+  double center = 0.5 * (a + b);
+  double half_length = 0.5 * (b - a);
+
+  double below[7], above[7];
+  for (int i = 0; i < 7; i++) {
+    below[i] = f(center - half_length * xgk[i]);
+    above[i] = f(center + half_length * xgk[i]);
+  }
+  double mid = f(center);
+
+  double kronrod = wgk[7] * mid;
+  double gauss = wg[3] * mid;
+  for (int i = 0; i < 7; i++) {
+    kronrod += wgk[i] * (below[i] + above[i]);
+    if (i % 2 == 1) gauss += wg[i / 2] * (below[i] + above[i]);
+  }
+
+  return {a, b, kronrod * half_length,
+          std::abs((kronrod - gauss) * half_length)};
+}
+
+/**
+ * Integrate a smooth function with adaptive Gauss-Kronrod (G7K15)
+ * quadrature.
+ *
+ * The segment with the largest error estimate is bisected until the sum of
+ * the error estimates is within the tolerance. Integrands that vary over
+ * several orders of magnitude should be transformed to a logarithmic
+ * variable first, so the default tolerance is reached with a few segments.
+ *
+ * @param[in] f integrand
+ * @param[in] a lower limit
+ * @param[in] b upper limit
+ * @param[in] rel_tol relative tolerance on the integral
+ * @param[in] max_segments maximum number of segments before giving up on
+ *  the tolerance and returning the current estimate
+ * @returns the integral of f from a to b
+ */
+template <typename Function>
+double integrate(const Function &f, double a, double b, double rel_tol = 1e-8,
+                 std::size_t max_segments = 100) {
+  std::vector<Segment> segments{rule(f, a, b)};
+  double result = segments.front().result;
+  double error = segments.front().error;
+  auto larger_error = [](const Segment &l, const Segment &r) {
+    return l.error < r.error;
+  };
+  while (error > rel_tol * std::abs(result) and
+         segments.size() < max_segments) {
+    std::pop_heap(segments.begin(), segments.end(), larger_error);
+    Segment worst{segments.back()};
+    segments.pop_back();
+
+    double center = 0.5 * (worst.a + worst.b);
+    for (const auto &half : {rule(f, worst.a, center),
+                             rule(f, center, worst.b)}) {
+      segments.push_back(half);
+      std::push_heap(segments.begin(), segments.end(), larger_error);
+    }
+
+    // re-sum instead of updating to avoid accumulating rounding errors
+    result = 0.;
+    error = 0.;
+    for (const auto &segment : segments) {
+      result += segment.result;
+      error += segment.error;
+    }
+  }
+  return result;
+}
+
+}  // namespace gausskronrod
+}  // namespace darkbrem
+}  // namespace g4fire
+
+#endif  // G4FIRE_DARKBREM_GAUSSKRONROD_H
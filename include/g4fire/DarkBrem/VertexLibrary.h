@@ -0,0 +1,215 @@
+#ifndef G4FIRE_DARKBREM_VERTEXLIBRARY_H
+#define G4FIRE_DARKBREM_VERTEXLIBRARY_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace g4fire {
+namespace darkbrem {
+
+/**
+ * @class VertexLibrary
+ *
+ * Library of dark brem vertices generated in MadGraph, binned by the
+ * energy of the incident electron.
+ *
+ * The library is either a directory of LHE files (which are parsed) or a
+ * single binary '.dblib' file (which is memory-mapped). The binary format
+ * holds the energy bins sorted by energy followed by one flat array of the
+ * vertices of all bins, so loading it costs nothing and all processes on a
+ * node share the same physical pages. A directory containing a '.dblib'
+ * file is loaded from that file instead of its LHE files.
+ *
+ * A store of binary libraries for many A' masses can be indexed by an
+ * 'index.dbidx' file (see writeIndex). Given the index (or the directory
+ * holding it), only the library of the configured mass is mapped, so one
+ * shared store serves every mass without scanning or parsing the others.
+ *
+ * The library is only loaded on the first access to its bins, so jobs
+ * that never produce a dark brem never read it.
+ *
+ * Binary libraries and indices are written with write() and writeIndex() or
+ * by the convert-vertex-library executable.
+ */
+class VertexLibrary {
+ public:
+  /**
+   * @struct Vertex
+   *
+   * The kinematics of a single dark brem vertex [GeV].
+   * The components are (px, py, pz, E).
+   */
+  struct Vertex {
+    /// 4-momentum of the outgoing electron
+    float electron[4];
+    /// 4-momentum of the electron-A' system
+    float center_momentum[4];
+  };
+
+  /**
+   * @struct Bin
+   *
+   * The vertices with the same incident electron energy.
+   */
+  struct Bin {
+    /// energy of the incident electron [GeV]
+    double energy;
+    /// index of the first vertex of this bin
+    uint64_t offset;
+    /// number of vertices in this bin
+    uint64_t count;
+  };
+
+  /**
+   * Vertices keyed by the energy of the incident electron [GeV].
+   */
+  typedef std::map<double, std::vector<Vertex>> VertexMap;
+
+  /// Name of the index of a store of binary libraries
+  static const std::string INDEX_NAME;
+
+  /**
+   * Check the input path without loading it.
+   *
+   * @throws fire::Exception if the path isn't a binary library, an index or
+   * a directory with an index, LHE files or a binary library in it
+   *
+   * @param[in] path path to the library
+   * @param[in] aprime_mass mass of the A' the vertices are for [GeV]
+   */
+  VertexLibrary(const std::string &path, double aprime_mass);
+
+  /// Unmap the binary library, if there is one
+  ~VertexLibrary();
+
+  /// The library may be memory-mapped, so it can't be copied
+  VertexLibrary(const VertexLibrary &) = delete;
+  VertexLibrary &operator=(const VertexLibrary &) = delete;
+
+  /**
+   * @return number of energy bins
+   */
+  std::size_t size() {
+    load();
+    return num_bins_;
+  }
+
+  /**
+   * @param[in] i_bin index of a bin
+   * @return the bin, the bins are sorted by increasing energy
+   */
+  const Bin &bin(std::size_t i_bin) {
+    load();
+    return bins_[i_bin];
+  }
+
+  /**
+   * @param[in] b a bin of this library
+   * @return pointer to the first of the b.count vertices of the bin
+   */
+  const Vertex *vertices(const Bin &b) {
+    load();
+    return vertices_ + b.offset;
+  }
+
+  /**
+   * Parse the dark brem vertices out of an LHE file.
+   *
+   * @throws fire::Exception if the file can't be opened or the A' mass
+   * of an event doesn't match
+   *
+   * @param[in] file_name path to the LHE file
+   * @param[in,out] aprime_mass mass of the A' [GeV], the events are checked
+   *  against it if it is positive, otherwise it is set to the mass of
+   *  the first event
+   * @param[in,out] vertices map to add the vertices to
+   */
+  static void parseLHE(const std::string &file_name, double &aprime_mass,
+                       VertexMap &vertices);
+
+  /**
+   * Write vertices to a binary library.
+   *
+   * @throws fire::Exception if the file can't be written
+   *
+   * @param[in] file_name path to the binary library
+   * @param[in] aprime_mass mass of the A' [GeV]
+   * @param[in] vertices the vertices to write
+   */
+  static void write(const std::string &file_name, double aprime_mass,
+                    const VertexMap &vertices);
+
+  /**
+   * Index the binary libraries in a directory.
+   *
+   * The index is a text file with one line per energy bin
+   *
+   *   mass energy file offset count
+   *
+   * with the masses and energies in GeV, the file of the bin relative to
+   * the directory and the offset and count of the vertices of the bin in
+   * that file.
+   *
+   * @throws fire::Exception if a library can't be read or the index can't
+   * be written
+   *
+   * @param[in] dir directory of binary libraries, the index is written
+   *  into it as INDEX_NAME
+   * @returns number of libraries indexed
+   */
+  static std::size_t writeIndex(const std::string &dir);
+
+ private:
+  /// Load the library unless it already is
+  void load() {
+    if (!loaded_) doLoad();
+  }
+
+  /// Map the binary library or parse the LHE files
+  void doLoad();
+
+  /// Find the library of our mass in the index and take its bins
+  void readIndex();
+
+  /// Map the binary library
+  void mapBinary();
+
+  /// Parse the LHE files into the owned storage
+  void parseLHEFiles();
+
+  /// Mass of the A' [GeV]
+  double aprime_mass_;
+
+  /// Binary library, empty if the library is LHE files
+  std::string binary_file_;
+
+  /// Index of a store of libraries, empty if there is none
+  std::string index_file_;
+
+  /// LHE files of the library, empty if it is a binary library
+  std::vector<std::string> lhe_files_;
+
+  /// Has the library been loaded?
+  bool loaded_{false};
+
+  /// Mapped binary library
+  void *mapping_{nullptr};
+  std::size_t mapping_size_{0};
+
+  /// Storage of the bins read from an index or parsed from LHE files
+  std::vector<Bin> owned_bins_;
+  /// Storage of the vertices parsed from LHE files
+  std::vector<Vertex> owned_vertices_;
+
+  /// Bins and vertices in use, either mapped or owned
+  const Bin *bins_{nullptr};
+  std::size_t num_bins_{0};
+  const Vertex *vertices_{nullptr};
+};
+
+}  // namespace darkbrem
+}  // namespace g4fire
+
+#endif  // G4FIRE_DARKBREM_VERTEXLIBRARY_H
@@ -0,0 +1,135 @@
+#ifndef G4FIRE_DARKBREM_WEIZSACKERWILLIAMS_H
+#define G4FIRE_DARKBREM_WEIZSACKERWILLIAMS_H
+
+#include "globals.hh"
+
+namespace g4fire {
+namespace darkbrem {
+
+/**
+ * @namespace ww
+ *
+ * The dark brem cross section in the Weizsacker-Williams approximation,
+ * shared by the models that need it for any A' mass.
+ */
+namespace ww {
+
+/**
+ * @struct Chi
+ *
+ * Stores parameters for chi function used in integration.
+ * Implements function as member operator.
+ *
+ * \f[ \chi(t) = \left(
+ * \frac{Z^2a^4t^2}{(1+a^2t)^2(1+t/d)^2}+\frac{Za_p^4t^2}{(1+a_p^2t)^2(1+t/0.71)^8}\left(\frac{1+t(m_{up}^2-1)}{4m_p^2}\right)^2\right)\frac{t-m_A^4/(4E_0^2)}{t^2}
+ * \f]
+ *
+ * where
+ * \f$m_A\f$ = mass of A' in GeV,
+ * \f$m_e\f$ = mass of electron in GeV,
+ * \f$E_0\f$ = incoming energy of electron in GeV,
+ * \f$A\f$ = atomic number of target atom,
+ * \f$Z\f$ = atomic mass of target atom,
+ * \f[a = \frac{111.0}{m_e Z^{1/3}}\f]
+ * \f[a_p = \frac{773.0}{m_e Z^{2/3}}\f]
+ * \f[d = \frac{0.164}{A^{2/3}}\f]
+ * \f$m_{up}\f$ = mass of up quark, and
+ * \f$m_{p}\f$ = mass of proton
+ */
+struct Chi {
+  /**
+   * Calculate the parts of chi that don't depend on t
+   *
+   * @param[in] A atomic mass
+   * @param[in] Z atomic number
+   * @param[in] E0 incoming beam energy [GeV]
+   * @param[in] MA A' mass [GeV]
+   * @param[in] Mel electron mass [GeV]
+   */
+  Chi(double A, double Z, double E0, double MA, double Mel);
+
+  /**
+   * Calculates chi at t
+   *
+   * Only uses products of the precomputed parameters, this is called
+   * a few hundred times for each cross section.
+   */
+  double operator()(double t) const;
+
+  /// atomic number
+  double Z;
+  /// \f$a^2\f$
+  double a2;
+  /// \f$a_p^2\f$
+  double ap2;
+  /// \f$1/d\f$
+  double d_inv;
+  /// \f$(m_{up}^2-1)/(4m_p^2)\f$
+  double up;
+  /// \f$m_A^4/(4E_0^2)\f$
+  double tmin;
+};
+
+/**
+ * @struct DiffCross
+ *
+ * Implementation of the differential scattering cross section.
+ * Stores parameters.
+ *
+ * Implements function as member operator.
+ *
+ * \f[ \frac{d\sigma}{dx}(x) =
+ * \sqrt{1-\frac{m_A^2}{E_0^2}}\frac{1-x+x^2/3}{m_A^2(1-x)/x+m_e^2x} \f]
+ *
+ * where
+ * \f$m_A\f$ = mass of A' in GeV
+ * \f$m_e\f$ = mass of electron in GeV
+ * \f$E_0\f$ = incoming energy of electron in GeV
+ */
+struct DiffCross {
+  /// incoming beam energy [GeV]
+  double E0;
+  /// A' mass [GeV]
+  double MA;
+  /// electron mass [GeV]
+  double Mel;
+
+  /**
+   * Calculates dsigma_dx from x and other paramters.
+   */
+  double operator()(double x) const;
+};
+
+/**
+ * Calculates the cross section per atom in GEANT4 internal units.
+ * Uses WW approximation to find the total cross section, performing numerical
+ * integrals over x and theta.
+ *
+ * Numerical integrals are done with adaptive Gauss-Kronrod quadrature
+ * (see GaussKronrod.h) on variables in which the integrands are smooth.
+ *
+ * Integrate Chi from \f$m_A^4/(4E_0^2)\f$ to \f$m_A^2\f$ in \f$\ln t\f$,
+ * since the form factors change over many orders of magnitude of t.
+ *
+ * Integrate DiffCross from 0 to \f$min(1-m_e/E_0,1-m_A/E_0)\f$ in
+ * \f$y = -\ln(1-x)\f$, which spreads out the peak at \f$x \to 1\f$.
+ *
+ * Total cross section is given by
+ * \f[ \sigma = 4 \frac{pb}{GeV} \epsilon^2 \alpha_{EW}^3 \int \chi(t)dt \int
+ * \frac{d\sigma}{dx}(x)dx \f]
+ *
+ * @param[in] E0 energy of the incoming electron [GeV]
+ * @param[in] A atomic mass of atom
+ * @param[in] Z atomic number of atom
+ * @param[in] MA mass of the A' [GeV]
+ * @param[in] epsilon strength of the dark photon - photon mixing
+ * @return cross section (0. if the A' can't be produced)
+ */
+G4double CrossSectionPerAtom(double E0, double A, double Z, double MA,
+                             double epsilon);
+
+}  // namespace ww
+}  // namespace darkbrem
+}  // namespace g4fire
+
+#endif  // G4FIRE_DARKBREM_WEIZSACKERWILLIAMS_H
@@ -26,7 +26,8 @@ namespace ldmx {
  * as contributions stored in vectors.  Contribution information includes a
  * reference to the relevant SimParticle, the PDG code of the actual particle
  * which deposited energy (may be different from the actual SimParticle), the
- * time of the contribution and the energy deposition.
+ * time of the contribution, the energy deposition and the weight of the
+ * contributing track.
  */
 class SimCalorimeterHit {
  public:
@@ -59,6 +60,16 @@ class SimCalorimeterHit {
 
     /// Time this contributor made the hit (global Geant4 time)
     float time{0};
+
+    /**
+     * Weight of this contributor on top of the event weight
+     *
+     * This is the track weight without the part that is already in the
+     * event weight, so it is one unless a biasing operator split or
+     * rouletted the track or one of its ancestors. Analyses of biased
+     * samples weight each contribution's edep by it and the event weight.
+     */
+    float weight{1.};
   };
 
   /**
@@ -95,6 +106,11 @@ class SimCalorimeterHit {
 
   /**
    * Get the energy deposition of the hit [MeV].
+   *
+   * If the contributions are saved, this is the sum of their unweighted
+   * edeps. Otherwise the edep of each step is weighted by the weight its
+   * contribution would have had.
+   *
    * @return The energy deposition of the hit.
    */
   float getEdep() const { return edep_; }
@@ -149,9 +165,10 @@ class SimCalorimeterHit {
    * @param pdgCode The PDG code of the actual track.
    * @param edep The energy deposition of the hit [MeV].
    * @param time The time of the hit [ns].
+   * @param weight The weight of the track on top of the event weight.
    */
   void addContrib(int incidentID, int trackID, int pdgCode, float edep,
-                  float time);
+                  float time, float weight = 1.);
 
   /**
    * Get a hit contribution by index.
@@ -161,12 +178,14 @@ class SimCalorimeterHit {
   Contrib getContrib(int i) const;
 
   /**
-   * Find the index of a hit contribution from a SimParticle and PDG code.
+   * Find the index of a hit contribution from a SimParticle, PDG code and
+   * track weight.
    * @param trackID the track ID of the particle causing the hit
    * @param pdgCode The PDG code of the contribution.
+   * @param weight The weight of the track on top of the event weight.
    * @return The index of the contribution or -1 if none exists.
    */
-  int findContribIndex(int trackID, int pdgCode) const;
+  int findContribIndex(int trackID, int pdgCode, float weight = 1.) const;
 
   /**
    * Update an existing hit contribution by incrementing its edep and setting
@@ -240,6 +259,11 @@ class SimCalorimeterHit {
    */
   std::vector<float> timeContribs_;
 
+  /**
+   * The list of the weights of the contributions.
+   */
+  std::vector<float> weightContribs_;
+
   /**
    * The number of hit contributions.
    */
@@ -248,7 +272,7 @@ class SimCalorimeterHit {
   /**
    * ROOT class definition.
    */
-  ClassDef(SimCalorimeterHit, 3)
+  ClassDef(SimCalorimeterHit, 4)
 };
 }  // namespace ldmx
 
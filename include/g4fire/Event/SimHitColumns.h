@@ -0,0 +1,750 @@
+/**
+ * @file SimHitColumns.h
+ * @brief Columnar (structure of arrays) layouts of the sim hit collections
+ */
+
+#ifndef SIMCORE_EVENT_SIMHITCOLUMNS_H_
+#define SIMCORE_EVENT_SIMHITCOLUMNS_H_
+
+// ROOT
+#include "TObject.h"  //For ClassDef
+
+// STL
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+// LDMX
+#include "g4fire/Event/SimCalorimeterHit.h"
+#include "g4fire/Event/SimTrackerHit.h"
+
+namespace ldmx {
+
+/**
+ * @class SimTrackerHitColumns
+ * @brief Columnar layout of a collection of SimTrackerHits
+ *
+ * @note
+ * Instead of storing one object per hit, every field of the hits in
+ * a collection is stored in its own contiguous array. The i'th entry of
+ * each array belongs to the i'th hit. This removes the per-object
+ * overhead when serializing the collection and allows downstream
+ * readers to process a single field of all hits with vectorized loops.
+ */
+class SimTrackerHitColumns {
+ public:
+  /**
+   * Class constructor.
+   */
+  SimTrackerHitColumns() = default;
+
+  /**
+   * Class destructor.
+   */
+  virtual ~SimTrackerHitColumns() = default;
+
+  /**
+   * Clear all of the columns.
+   */
+  void Clear();
+
+  /**
+   * Print out the object.
+   */
+  void Print() const;
+
+  /**
+   * Reserve space in every column.
+   * @param n The number of hits to reserve space for.
+   */
+  void reserve(std::size_t n);
+
+  /**
+   * Append a hit to the end of the columns.
+   * @param hit The hit to append.
+   */
+  void append(const SimTrackerHit &hit);
+
+  /**
+   * Clear the columns and fill them from a collection of hits.
+   * @param hits The collection of hits to copy.
+   */
+  void fill(const std::vector<SimTrackerHit> &hits);
+
+  /**
+   * @return The number of hits stored in the columns.
+   */
+  std::size_t size() const { return id_.size(); }
+
+  /**
+   * Get a hit by index, building it from the columns.
+   * @param i The index of the hit.
+   * @return The hit at the index.
+   */
+  SimTrackerHit getHit(std::size_t i) const;
+
+  /// Detector IDs
+  std::vector<int> id_;
+
+  /// Layer IDs
+  std::vector<int> layerID_;
+
+  /// Module IDs
+  std::vector<int> moduleID_;
+
+  /// Energy depositions [MeV]
+  std::vector<float> edep_;
+
+  /// Global times [ns]
+  std::vector<float> time_;
+
+  /// X momenta [MeV]
+  std::vector<float> px_;
+
+  /// Y momenta [MeV]
+  std::vector<float> py_;
+
+  /// Z momenta [MeV]
+  std::vector<float> pz_;
+
+  /// Total energies of the particles [MeV]
+  std::vector<float> energy_;
+
+  /// X positions [mm]
+  std::vector<float> x_;
+
+  /// Y positions [mm]
+  std::vector<float> y_;
+
+  /// Z positions [mm]
+  std::vector<float> z_;
+
+  /// Path lengths through the sensitive volume [mm]
+  std::vector<float> pathLength_;
+
+  /// Geant4 track IDs
+  std::vector<int> trackID_;
+
+  /// PDG IDs
+  std::vector<int> pdgID_;
+
+  /// Weights of the tracks
+  std::vector<float> weight_;
+
+  /**
+   * ROOT class definition.
+   */
+  ClassDef(SimTrackerHitColumns, 2)
+};
+
+/**
+ * @class SimCalorimeterHitColumns
+ * @brief Columnar layout of a collection of SimCalorimeterHits
+ *
+ * @note
+ * The per-hit fields are stored in one contiguous array each, with the
+ * i'th entry belonging to the i'th hit. The contributions of all hits
+ * are concatenated into a second set of arrays. The contributions of hit
+ * i are found at the indices [contribOffsets_[i], contribOffsets_[i+1]),
+ * so contribOffsets_ always holds one more entry than there are hits.
+ */
+class SimCalorimeterHitColumns {
+ public:
+  /**
+   * Class constructor.
+   */
+  SimCalorimeterHitColumns() = default;
+
+  /**
+   * Class destructor.
+   */
+  virtual ~SimCalorimeterHitColumns() = default;
+
+  /**
+   * Clear all of the columns.
+   */
+  void Clear();
+
+  /**
+   * Print out the object.
+   */
+  void Print() const;
+
+  /**
+   * Append a hit and its contributions to the end of the columns.
+   * @param hit The hit to append.
+   */
+  void append(const SimCalorimeterHit &hit);
+
+  /**
+   * Clear the columns and fill them from a collection of hits.
+   * @param hits The collection of hits to copy.
+   */
+  void fill(const std::vector<SimCalorimeterHit> &hits);
+
+  /**
+   * @return The number of hits stored in the columns.
+   */
+  std::size_t size() const { return id_.size(); }
+
+  /**
+   * @return The total number of contributions stored in the columns.
+   */
+  std::size_t getNumberOfContribs() const { return edepContribs_.size(); }
+
+  /**
+   * Get a hit by index, building it (and its contributions) from the
+   * columns.
+   * @param i The index of the hit.
+   * @return The hit at the index.
+   */
+  SimCalorimeterHit getHit(std::size_t i) const;
+
+  /// Detector IDs
+  std::vector<int> id_;
+
+  /// Energy depositions [MeV]
+  std::vector<float> edep_;
+
+  /// X positions [mm]
+  std::vector<float> x_;
+
+  /// Y positions [mm]
+  std::vector<float> y_;
+
+  /// Z positions [mm]
+  std::vector<float> z_;
+
+  /// Global times [ns]
+  std::vector<float> time_;
+
+  /// Index of the first contribution of each hit, plus the total count
+  std::vector<unsigned> contribOffsets_{0};
+
+  /// Incident IDs of all contributions
+  std::vector<int> incidentIDContribs_;
+
+  /// Track IDs of all contributions
+  std::vector<int> trackIDContribs_;
+
+  /// PDG codes of all contributions
+  std::vector<int> pdgCodeContribs_;
+
+  /// Energy depositions of all contributions [MeV]
+  std::vector<float> edepContribs_;
+
+  /// Times of all contributions [ns]
+  std::vector<float> timeContribs_;
+
+  /// Track weights of all contributions
+  std::vector<float> weightContribs_;
+
+  /**
+   * ROOT class definition.
+   */
+  ClassDef(SimCalorimeterHitColumns, 2)
+};
+
+/**
+ * @struct QuantizationSteps
+ * @brief Step sizes of the fixed-point fields of a quantized collection
+ *
+ * A step of zero (or less) stores the raw bits of the float instead, so
+ * that field keeps its full precision. The steps are not used by the
+ * half-precision layouts.
+ */
+struct QuantizationSteps {
+  /// Step size of the positions [mm]
+  double position{0.};
+
+  /// Step size of the momenta [MeV]
+  double momentum{0.};
+
+  /// Step size of the total energies [MeV]
+  double energy{0.};
+
+  /// Step size of the energy depositions [MeV]
+  double edep{0.};
+
+  /// Step size of the times [ns]
+  double time{0.};
+
+  /// Step size of the path lengths [mm]
+  double pathLength{0.};
+};
+
+/**
+ * Encoding of single values into the codes of the quantized layouts
+ */
+namespace quantization {
+
+/**
+ * Encode a value as the nearest multiple of a step.
+ *
+ * Values whose multiple does not fit into 32 bits saturate. A step of
+ * zero (or less) returns the bit pattern of the float itself.
+ *
+ * @param[in] value value to encode
+ * @param[in] step step size of the field
+ * @return fixed-point code
+ */
+std::int32_t toFixed(float value, double step);
+
+/**
+ * Decode a fixed-point code.
+ *
+ * @param[in] code fixed-point code
+ * @param[in] step step size the code was encoded with
+ * @return decoded value
+ */
+float fromFixed(std::int32_t code, double step);
+
+/**
+ * Encode a value as an IEEE half-precision float.
+ *
+ * The mantissa is rounded to nearest-even. Finite values beyond the
+ * half-precision range (65504) saturate to the largest half.
+ *
+ * @param[in] value value to encode
+ * @return bit pattern of the half-precision float
+ */
+std::uint16_t toHalf(float value);
+
+/**
+ * Decode an IEEE half-precision float.
+ *
+ * @param[in] code bit pattern of the half-precision float
+ * @return decoded value
+ */
+float fromHalf(std::uint16_t code);
+
+/// Overloads selecting the encoding from the code type
+inline void encode(float value, double step, std::int32_t &code) {
+  code = toFixed(value, step);
+}
+inline void encode(float value, double, std::uint16_t &code) {
+  code = toHalf(value);
+}
+inline float decode(std::int32_t code, double step) {
+  return fromFixed(code, step);
+}
+inline float decode(std::uint16_t code, double) { return fromHalf(code); }
+
+/**
+ * Encode a value into a code of the given type.
+ *
+ * @param[in] value value to encode
+ * @param[in] step step size of the field (only used by fixed-point codes)
+ * @return code of the value
+ */
+template <typename Code>
+Code encode(float value, double step) {
+  Code code;
+  encode(value, step, code);
+  return code;
+}
+
+}  // namespace quantization
+
+/**
+ * @class QuantizedSimTrackerHitColumns
+ * @brief Columnar layout of a collection of SimTrackerHits with the
+ * kinematic fields stored as reduced-precision codes
+ *
+ * @note
+ * The layout matches SimTrackerHitColumns, but every kinematic field is
+ * stored as a Code instead of a float. With 32-bit fixed-point codes
+ * (FixedSimTrackerHitColumns) a field is a multiple of its step size,
+ * the steps are stored alongside the codes. With 16-bit codes
+ * (HalfSimTrackerHitColumns) a field is an IEEE half-precision float.
+ * IDs, track IDs, PDG IDs and track weights are stored as they are.
+ *
+ * @tparam Code type of the codes of the kinematic fields
+ */
+template <typename Code>
+class QuantizedSimTrackerHitColumns {
+ public:
+  /**
+   * Class constructor.
+   */
+  QuantizedSimTrackerHitColumns() = default;
+
+  /**
+   * Class destructor.
+   */
+  virtual ~QuantizedSimTrackerHitColumns() = default;
+
+  /**
+   * Clear all of the columns.
+   */
+  void Clear();
+
+  /**
+   * Print out the object.
+   */
+  void Print() const;
+
+  /**
+   * Clear the columns and fill them with the encoded hits.
+   * @param hits The collection of hits to encode.
+   * @param steps The step sizes of the fixed-point fields.
+   */
+  void fill(const std::vector<SimTrackerHit> &hits,
+            const QuantizationSteps &steps);
+
+  /**
+   * @return The number of hits stored in the columns.
+   */
+  std::size_t size() const { return id_.size(); }
+
+  /**
+   * Get a hit by index, decoding it from the columns.
+   * @param i The index of the hit.
+   * @return The hit at the index.
+   */
+  SimTrackerHit getHit(std::size_t i) const;
+
+  /// Step sizes the fixed-point fields were encoded with
+  QuantizationSteps steps_;
+
+  /// Detector IDs
+  std::vector<int> id_;
+
+  /// Layer IDs
+  std::vector<int> layerID_;
+
+  /// Module IDs
+  std::vector<int> moduleID_;
+
+  /// Energy depositions [MeV]
+  std::vector<Code> edep_;
+
+  /// Global times [ns]
+  std::vector<Code> time_;
+
+  /// X momenta [MeV]
+  std::vector<Code> px_;
+
+  /// Y momenta [MeV]
+  std::vector<Code> py_;
+
+  /// Z momenta [MeV]
+  std::vector<Code> pz_;
+
+  /// Total energies of the particles [MeV]
+  std::vector<Code> energy_;
+
+  /// X positions [mm]
+  std::vector<Code> x_;
+
+  /// Y positions [mm]
+  std::vector<Code> y_;
+
+  /// Z positions [mm]
+  std::vector<Code> z_;
+
+  /// Path lengths through the sensitive volume [mm]
+  std::vector<Code> pathLength_;
+
+  /// Geant4 track IDs
+  std::vector<int> trackID_;
+
+  /// PDG IDs
+  std::vector<int> pdgID_;
+
+  /// Weights of the tracks
+  std::vector<float> weight_;
+
+  /**
+   * ROOT class definition.
+   */
+  ClassDef(QuantizedSimTrackerHitColumns, 2)
+};
+
+/// Tracker hits with fixed-point kinematics
+typedef QuantizedSimTrackerHitColumns<std::int32_t> FixedSimTrackerHitColumns;
+
+/// Tracker hits with half-precision kinematics
+typedef QuantizedSimTrackerHitColumns<std::uint16_t> HalfSimTrackerHitColumns;
+
+/**
+ * @class QuantizedSimCalorimeterHitColumns
+ * @brief Columnar layout of a collection of SimCalorimeterHits with the
+ * kinematic fields stored as reduced-precision codes
+ *
+ * @note
+ * The layout matches SimCalorimeterHitColumns, but the positions, energy
+ * depositions and times of the hits and their contributions are stored
+ * as Codes instead of floats (see QuantizedSimTrackerHitColumns). The
+ * track weights of the contributions are stored as they are.
+ *
+ * @tparam Code type of the codes of the kinematic fields
+ */
+template <typename Code>
+class QuantizedSimCalorimeterHitColumns {
+ public:
+  /**
+   * Class constructor.
+   */
+  QuantizedSimCalorimeterHitColumns() = default;
+
+  /**
+   * Class destructor.
+   */
+  virtual ~QuantizedSimCalorimeterHitColumns() = default;
+
+  /**
+   * Clear all of the columns.
+   */
+  void Clear();
+
+  /**
+   * Print out the object.
+   */
+  void Print() const;
+
+  /**
+   * Clear the columns and fill them with the encoded hits.
+   * @param hits The collection of hits to encode.
+   * @param steps The step sizes of the fixed-point fields.
+   */
+  void fill(const std::vector<SimCalorimeterHit> &hits,
+            const QuantizationSteps &steps);
+
+  /**
+   * @return The number of hits stored in the columns.
+   */
+  std::size_t size() const { return id_.size(); }
+
+  /**
+   * @return The total number of contributions stored in the columns.
+   */
+  std::size_t getNumberOfContribs() const { return edepContribs_.size(); }
+
+  /**
+   * Get a hit by index, decoding it (and its contributions) from the
+   * columns.
+   * @param i The index of the hit.
+   * @return The hit at the index.
+   */
+  SimCalorimeterHit getHit(std::size_t i) const;
+
+  /// Step sizes the fixed-point fields were encoded with
+  QuantizationSteps steps_;
+
+  /// Detector IDs
+  std::vector<int> id_;
+
+  /// Energy depositions [MeV]
+  std::vector<Code> edep_;
+
+  /// X positions [mm]
+  std::vector<Code> x_;
+
+  /// Y positions [mm]
+  std::vector<Code> y_;
+
+  /// Z positions [mm]
+  std::vector<Code> z_;
+
+  /// Global times [ns]
+  std::vector<Code> time_;
+
+  /// Index of the first contribution of each hit, plus the total count
+  std::vector<unsigned> contribOffsets_{0};
+
+  /// Incident IDs of all contributions
+  std::vector<int> incidentIDContribs_;
+
+  /// Track IDs of all contributions
+  std::vector<int> trackIDContribs_;
+
+  /// PDG codes of all contributions
+  std::vector<int> pdgCodeContribs_;
+
+  /// Energy depositions of all contributions [MeV]
+  std::vector<Code> edepContribs_;
+
+  /// Times of all contributions [ns]
+  std::vector<Code> timeContribs_;
+
+  /// Track weights of all contributions
+  std::vector<float> weightContribs_;
+
+  /**
+   * ROOT class definition.
+   */
+  ClassDef(QuantizedSimCalorimeterHitColumns, 2)
+};
+
+/// Calorimeter hits with fixed-point kinematics
+typedef QuantizedSimCalorimeterHitColumns<std::int32_t>
+    FixedSimCalorimeterHitColumns;
+
+/// Calorimeter hits with half-precision kinematics
+typedef QuantizedSimCalorimeterHitColumns<std::uint16_t>
+    HalfSimCalorimeterHitColumns;
+
+template <typename Code>
+void QuantizedSimTrackerHitColumns<Code>::Clear() {
+  steps_ = QuantizationSteps();
+  id_.clear();
+  layerID_.clear();
+  moduleID_.clear();
+  edep_.clear();
+  time_.clear();
+  px_.clear();
+  py_.clear();
+  pz_.clear();
+  energy_.clear();
+  x_.clear();
+  y_.clear();
+  z_.clear();
+  pathLength_.clear();
+  trackID_.clear();
+  pdgID_.clear();
+  weight_.clear();
+}
+
+template <typename Code>
+void QuantizedSimTrackerHitColumns<Code>::Print() const {
+  std::cout << "QuantizedSimTrackerHitColumns { "
+            << "num hits: " << size() << ", code size: " << sizeof(Code)
+            << " }" << std::endl;
+}
+
+template <typename Code>
+void QuantizedSimTrackerHitColumns<Code>::fill(
+    const std::vector<SimTrackerHit> &hits, const QuantizationSteps &steps) {
+  using quantization::encode;
+  Clear();
+  steps_ = steps;
+  for (const auto &hit : hits) {
+    auto position{hit.getPosition()};
+    auto momentum{hit.getMomentum()};
+    id_.push_back(hit.getID());
+    layerID_.push_back(hit.getLayerID());
+    moduleID_.push_back(hit.getModuleID());
+    edep_.push_back(encode<Code>(hit.getEdep(), steps_.edep));
+    time_.push_back(encode<Code>(hit.getTime(), steps_.time));
+    px_.push_back(encode<Code>(momentum[0], steps_.momentum));
+    py_.push_back(encode<Code>(momentum[1], steps_.momentum));
+    pz_.push_back(encode<Code>(momentum[2], steps_.momentum));
+    energy_.push_back(encode<Code>(hit.getEnergy(), steps_.energy));
+    x_.push_back(encode<Code>(position[0], steps_.position));
+    y_.push_back(encode<Code>(position[1], steps_.position));
+    z_.push_back(encode<Code>(position[2], steps_.position));
+    pathLength_.push_back(
+        encode<Code>(hit.getPathLength(), steps_.pathLength));
+    trackID_.push_back(hit.getTrackID());
+    pdgID_.push_back(hit.getPdgID());
+    weight_.push_back(hit.getWeight());
+  }
+}
+
+template <typename Code>
+SimTrackerHit QuantizedSimTrackerHitColumns<Code>::getHit(
+    std::size_t i) const {
+  using quantization::decode;
+  SimTrackerHit hit;
+  hit.setID(id_.at(i));
+  hit.setLayerID(layerID_.at(i));
+  hit.setModuleID(moduleID_.at(i));
+  hit.setEdep(decode(edep_.at(i), steps_.edep));
+  hit.setTime(decode(time_.at(i), steps_.time));
+  hit.setMomentum(decode(px_.at(i), steps_.momentum),
+                  decode(py_.at(i), steps_.momentum),
+                  decode(pz_.at(i), steps_.momentum));
+  hit.setEnergy(decode(energy_.at(i), steps_.energy));
+  hit.setPosition(decode(x_.at(i), steps_.position),
+                  decode(y_.at(i), steps_.position),
+                  decode(z_.at(i), steps_.position));
+  hit.setPathLength(decode(pathLength_.at(i), steps_.pathLength));
+  hit.setTrackID(trackID_.at(i));
+  hit.setPdgID(pdgID_.at(i));
+  hit.setWeight(weight_.at(i));
+  return hit;
+}
+
+template <typename Code>
+void QuantizedSimCalorimeterHitColumns<Code>::Clear() {
+  steps_ = QuantizationSteps();
+  id_.clear();
+  edep_.clear();
+  x_.clear();
+  y_.clear();
+  z_.clear();
+  time_.clear();
+  contribOffsets_.assign(1, 0);
+  incidentIDContribs_.clear();
+  trackIDContribs_.clear();
+  pdgCodeContribs_.clear();
+  edepContribs_.clear();
+  timeContribs_.clear();
+  weightContribs_.clear();
+}
+
+template <typename Code>
+void QuantizedSimCalorimeterHitColumns<Code>::Print() const {
+  std::cout << "QuantizedSimCalorimeterHitColumns { "
+            << "num hits: " << size()
+            << ", num contribs: " << getNumberOfContribs()
+            << ", code size: " << sizeof(Code) << " }" << std::endl;
+}
+
+template <typename Code>
+void QuantizedSimCalorimeterHitColumns<Code>::fill(
+    const std::vector<SimCalorimeterHit> &hits,
+    const QuantizationSteps &steps) {
+  using quantization::encode;
+  Clear();
+  steps_ = steps;
+  for (const auto &hit : hits) {
+    auto position{hit.getPosition()};
+    id_.push_back(hit.getID());
+    edep_.push_back(encode<Code>(hit.getEdep(), steps_.edep));
+    x_.push_back(encode<Code>(position[0], steps_.position));
+    y_.push_back(encode<Code>(position[1], steps_.position));
+    z_.push_back(encode<Code>(position[2], steps_.position));
+    time_.push_back(encode<Code>(hit.getTime(), steps_.time));
+
+    for (unsigned iContrib = 0; iContrib < hit.getNumberOfContribs();
+         iContrib++) {
+      SimCalorimeterHit::Contrib contrib = hit.getContrib(iContrib);
+      incidentIDContribs_.push_back(contrib.incidentID);
+      trackIDContribs_.push_back(contrib.trackID);
+      pdgCodeContribs_.push_back(contrib.pdgCode);
+      edepContribs_.push_back(encode<Code>(contrib.edep, steps_.edep));
+      timeContribs_.push_back(encode<Code>(contrib.time, steps_.time));
+      weightContribs_.push_back(contrib.weight);
+    }
+    contribOffsets_.push_back(edepContribs_.size());
+  }
+}
+
+template <typename Code>
+SimCalorimeterHit QuantizedSimCalorimeterHitColumns<Code>::getHit(
+    std::size_t i) const {
+  using quantization::decode;
+  SimCalorimeterHit hit;
+  hit.setID(id_.at(i));
+  hit.setPosition(decode(x_.at(i), steps_.position),
+                  decode(y_.at(i), steps_.position),
+                  decode(z_.at(i), steps_.position));
+  for (unsigned iContrib = contribOffsets_.at(i);
+       iContrib < contribOffsets_.at(i + 1); iContrib++) {
+    hit.addContrib(incidentIDContribs_[iContrib], trackIDContribs_[iContrib],
+                   pdgCodeContribs_[iContrib],
+                   decode(edepContribs_[iContrib], steps_.edep),
+                   decode(timeContribs_[iContrib], steps_.time),
+                   weightContribs_[iContrib]);
+  }
+  // the totals are encoded on their own so their error stays bounded
+  hit.setEdep(decode(edep_.at(i), steps_.edep));
+  hit.setTime(decode(time_.at(i), steps_.time));
+  return hit;
+}
+
+}  // namespace ldmx
+
+#endif
@@ -112,6 +112,16 @@ class SimTrackerHit {
    */
   int getPdgID() const { return pdgID_; };
 
+  /**
+   * Get the weight of the hit on top of the event weight.
+   *
+   * This is the weight of the track that made the hit without the part
+   * that is already in the event weight. It is one unless a biasing
+   * operator split or rouletted the track or one of its ancestors.
+   * @return The weight of the hit.
+   */
+  float getWeight() const { return weight_; };
+
   /**
    * Set the detector ID of the hit.
    * @param id The detector ID of the hit.
@@ -186,6 +196,12 @@ class SimTrackerHit {
    */
   void setPdgID(const int simPdgID) { this->pdgID_ = simPdgID; };
 
+  /**
+   * Set the weight of the hit on top of the event weight.
+   * @param weight The weight of the hit.
+   */
+  void setWeight(const float weight) { this->weight_ = weight; };
+
   /**
    * Sort by time of hit
    */
@@ -267,10 +283,15 @@ class SimTrackerHit {
    */
   int pdgID_{0};
 
+  /**
+   * The weight of the hit on top of the event weight.
+   */
+  float weight_{1.};
+
   /**
    * The ROOT class definition.
    */
-  ClassDef(SimTrackerHit, 3);
+  ClassDef(SimTrackerHit, 4);
 
 };  // SimTrackerHit
 }  // namespace ldmx
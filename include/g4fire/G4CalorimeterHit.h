@@ -146,6 +146,18 @@ class G4CalorimeterHit : public G4VHit {
    */
   void setPdgCode(int pdgCode) { pdgCode_ = pdgCode; }
 
+  /**
+   * Get the weight of this hit on top of the event weight.
+   * @return The weight of the hit.
+   */
+  float getWeight() { return weight_; }
+
+  /**
+   * Set the weight of this hit on top of the event weight.
+   * @param weight The weight of the hit.
+   */
+  void setWeight(float weight) { weight_ = weight; }
+
  private:
   /**
    * The track ID.
@@ -176,6 +188,11 @@ class G4CalorimeterHit : public G4VHit {
    * The PDG code.
    */
   int pdgCode_{0};
+
+  /**
+   * The weight of the hit on top of the event weight.
+   */
+  float weight_{1.};
 };
 
 /**
@@ -220,6 +220,18 @@ class G4TrackerHit : public G4VHit {
    */
   void setPathLength(float pathLength) { this->pathLength_ = pathLength; }
 
+  /**
+   * Get the weight of this hit on top of the event weight.
+   * @return The weight of the hit.
+   */
+  float getWeight() { return weight_; }
+
+  /**
+   * Set the weight of this hit on top of the event weight.
+   * @param weight The weight of the hit.
+   */
+  void setWeight(float weight) { this->weight_ = weight; }
+
  private:
   /**
    * The track ID.
@@ -272,6 +284,11 @@ class G4TrackerHit : public G4VHit {
    * The path length.
    */
   float pathLength_{0};
+
+  /**
+   * The weight of the hit on top of the event weight.
+   */
+  float weight_{1.};
 };
 
 /**
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <map>
+#include <string>
+
 #include "G4GDMLParser.hh"
 
 //#include "DetDescr/DetectorHeader.h"
@@ -7,6 +10,10 @@
 #include "fire/config/Parameters.h"
 
 #include "g4fire/ConditionsInterface.h"
+#include "g4fire/Geo/FieldIntegration.h"
+
+class G4FieldManager;
+class G4LogicalVolume;
 
 namespace g4fire::geo {
 
@@ -83,6 +90,27 @@ private:
   void createVisAttributes(G4String name,
                            const G4GDMLAuxListType *aux_info_list);
 
+  /**
+   * Give the regions with field integration settings their own field
+   * manager and apply the settings to the managers of their root volumes.
+   */
+  void assignFieldIntegrationToRegions();
+
+  /**
+   * Get the field integration settings of a field or region.
+   *
+   * The settings of the referenced GDML block are updated with the
+   * overrides from the configuration.
+   *
+   * @param kind Kind of the target, "field" or "region".
+   * @param name The name of the field or region.
+   * @param refs Names of the blocks referenced by targets of this kind.
+   * @return The field integration settings.
+   */
+  FieldIntegration
+  getFieldIntegration(const std::string &kind, const std::string &name,
+                      const std::map<std::string, std::string> &refs) const;
+
   /**
    * Create the detector header from the global auxinfo.
    * @param detector_version The aux value with the detector version.
@@ -108,6 +136,21 @@ private:
 
   /// ConditionsInterface
   ConditionsInterface &conditions_intf_;
+
+  /// Field integration blocks by name
+  std::map<std::string, FieldIntegration> field_integrations_;
+
+  /// Field integration blocks referenced by the magnetic fields
+  std::map<std::string, std::string> field_integration_refs_;
+
+  /// Field integration blocks referenced by the regions
+  std::map<std::string, std::string> region_integration_refs_;
+
+  /// Name of the field assigned to the world, if any
+  std::string global_field_;
+
+  /// Field managers created for volumes referencing a magnetic field
+  std::map<G4LogicalVolume *, G4FieldManager *> volume_field_managers_;
 };
 
 } // namespace g4fire::geo
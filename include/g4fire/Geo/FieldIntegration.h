@@ -0,0 +1,110 @@
+#pragma once
+
+#include <string>
+
+#include "G4GDMLAuxStructType.hh"
+
+#include "fire/config/Parameters.h"
+
+class G4FieldManager;
+class G4GDMLEvaluator;
+
+namespace g4fire::geo {
+
+/**
+ * @brief Accuracy and stepper settings of the integration of tracks in a
+ * magnetic field.
+ *
+ * @note
+ * Only the settings that are explicitly given are applied, everything else
+ * is left at the defaults of the field manager. This allows cheap, low
+ * order integration in regions where the bending barely matters (e.g. the
+ * calorimeters) while the tracker keeps the full precision.
+ *
+ * The settings are read from a FieldIntegration block of the GDML userinfo
+ *
+ * @code{.xml}
+ * <auxiliary auxtype="FieldIntegration" auxvalue="CalorimeterIntegration">
+ *   <auxiliary auxtype="Stepper" auxvalue="SimpleRunge"/>
+ *   <auxiliary auxtype="DeltaChord" auxvalue="1.0" auxunit="mm"/>
+ *   <auxiliary auxtype="DeltaOneStep" auxvalue="0.1" auxunit="mm"/>
+ *   <auxiliary auxtype="DeltaIntersection" auxvalue="0.1" auxunit="mm"/>
+ *   <auxiliary auxtype="EpsilonMin" auxvalue="1e-5"/>
+ *   <auxiliary auxtype="EpsilonMax" auxvalue="1e-3"/>
+ *   <auxiliary auxtype="MinStep" auxvalue="0.1" auxunit="mm"/>
+ * </auxiliary>
+ * @endcode
+ *
+ * which is referenced by name with a FieldIntegration key in a
+ * MagneticField or Region block. The same settings can be overridden from
+ * the python configuration.
+ */
+class FieldIntegration {
+public:
+  /// No settings, nothing is changed when applied
+  FieldIntegration() = default;
+
+  /**
+   * Update the settings from the contents of a GDML FieldIntegration block.
+   *
+   * @param[in] aux_info_list The aux info of the block.
+   * @param[in] eval Evaluator of the values with their units.
+   */
+  void update(const G4GDMLAuxListType *aux_info_list, G4GDMLEvaluator *eval);
+
+  /**
+   * Update the settings from the python configuration.
+   *
+   * Lengths are in mm, negative values (and an empty stepper) are ignored.
+   *
+   * @param[in] params The configured overrides.
+   */
+  void update(const fire::config::Parameters &params);
+
+  /**
+   * Update the settings with all settings given in another instance.
+   *
+   * @param[in] other The settings that take precedence.
+   */
+  void update(const FieldIntegration &other);
+
+  /**
+   * Apply the settings to a field manager.
+   *
+   * A new chord finder is created if the stepper or the minimum step is
+   * changed, so the field manager must already hold its field. It replaces
+   * (and deletes) the chord finder of the manager, which must own it, i.e.
+   * the manager was created with its magnetic field or by
+   * CreateChordFinder.
+   *
+   * @param[in] mgr The field manager to configure.
+   */
+  void apply(G4FieldManager *mgr) const;
+
+  /// @return true if no setting is given
+  bool empty() const;
+
+private:
+  /// Name of the stepper class (e.g. "ClassicalRK4"), empty for the default
+  std::string stepper_;
+
+  /// Maximum miss distance of a chord [mm]
+  double delta_chord_{-1.};
+
+  /// Accuracy of the end point of a step [mm]
+  double delta_one_step_{-1.};
+
+  /// Accuracy of the intersection with a boundary [mm]
+  double delta_intersection_{-1.};
+
+  /// Minimum relative accuracy of a step
+  double epsilon_min_{-1.};
+
+  /// Maximum relative accuracy of a step
+  double epsilon_max_{-1.};
+
+  /// Minimum step of the chord finder [mm]
+  double min_step_{-1.};
+};
+
+} // namespace g4fire::geo
@@ -0,0 +1,123 @@
+#ifndef G4FIRE_LOOPERPOLICY_H
+#define G4FIRE_LOOPERPOLICY_H
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "G4Region.hh"
+#include "G4Step.hh"
+
+#include "fire/config/Parameters.h"
+
+namespace g4fire {
+
+/**
+ * Kills particles that loop in a magnetic field.
+ *
+ * Low momentum charged particles can spiral in a field for a very large
+ * number of transportation steps before the Geant4 looper thresholds kill
+ * them. A step is looping if the field propagator gave up on it before
+ * reaching its end. For every track, the consecutive looping steps are
+ * counted and the track is killed according to the thresholds of the
+ * region it is in.
+ *
+ * <ul>
+ * <li>Tracks below the warning energy are killed on their first looping
+ * step.</li>
+ * <li>Tracks below the important energy are killed once they took the
+ * maximum number of looping steps (never if it is zero).</li>
+ * <li>Tracks at or above the important energy are never killed.</li>
+ * </ul>
+ *
+ * Geant4's transportation kills looping tracks on its own thresholds
+ * before the policy sees them, so those are relaxed to the loosest policy
+ * (see configureTransportation). The tracks Geant4 still kills are
+ * counted along with the ones killed by the policy.
+ *
+ * The number of killed tracks and the kinetic energy they carried are
+ * counted in the event information.
+ */
+class LooperPolicy {
+ public:
+  /**
+   * Configure the thresholds.
+   *
+   * @param[in] policies thresholds of each region, a policy without region
+   *  (or with an empty one) applies to all other regions
+   */
+  LooperPolicy(const std::vector<fire::config::Parameters> &policies);
+
+  /// Destructor
+  ~LooperPolicy() = default;
+
+  /**
+   * Relax the looper thresholds of Geant4's transportation processes.
+   *
+   * Geant4 kills looping tracks below its important energy on their first
+   * looping step and all others after its number of trials. The important
+   * energy is lowered to the smallest warning energy of all policies. The
+   * trials are raised to the largest number of looping steps of the
+   * policies so Geant4 still protects the regions without a policy and the
+   * policies that never kill on their number of looping steps. Only if a
+   * policy applies to all regions and every policy has a maximum number of
+   * looping steps, the trials are disabled since the policies take over
+   * entirely.
+   *
+   * This needs to be called after the physics has been constructed.
+   */
+  void configureTransportation() const;
+
+  /**
+   * Check if the track of the input step is looping and kill it if
+   * the policy of its region says so.
+   *
+   * Only charged tracks in a volume with a field can loop, the looping
+   * steps of all others are reset.
+   *
+   * @param[in] step current step
+   */
+  void stepping(const G4Step *step);
+
+ private:
+  /// Thresholds of a single region
+  struct Thresholds {
+    /// tracks below this kinetic energy are killed immediately [MeV]
+    double warning_energy;
+    /// tracks at or above this kinetic energy are never killed [MeV]
+    double important_energy;
+    /// number of looping steps before a track is killed, 0 for never
+    int max_looping_steps;
+  };
+
+  /**
+   * Relax the looper thresholds of a single transportation process.
+   *
+   * @param[in] transport the transportation process
+   */
+  template <typename Transport>
+  void configure(Transport *transport) const;
+
+  /**
+   * Get the thresholds of a region.
+   *
+   * @param[in] region the region
+   * @return the thresholds, nullptr if the region is not handled
+   */
+  const Thresholds *getThresholds(const G4Region *region);
+
+  /// Thresholds by region name
+  std::map<std::string, Thresholds> thresholds_;
+
+  /// Thresholds of all other regions, if configured
+  bool has_default_{false};
+  Thresholds default_;
+
+  /// Thresholds already looked up for a region
+  std::unordered_map<const G4Region *, const Thresholds *> by_region_;
+};
+
+}  // namespace g4fire
+
+#endif  // G4FIRE_LOOPERPOLICY_H
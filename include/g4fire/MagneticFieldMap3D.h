@@ -2,6 +2,8 @@
 
 #include "G4MagneticField.hh"
 
+#include <cstdint>
+#include <string>
 #include <vector>
 
 using std::vector;
@@ -46,6 +48,26 @@ namespace g4fire {
  *
  * x y z B_x B_y B_z
  *
+ * Mirror symmetries in x and/or y (about the planes x = 0 and y = 0 of
+ * the map coordinates) can be declared with the sign each field component
+ * takes in the mirrored half, e.g. "-++" if only B_x flips sign. Only the
+ * fundamental region (x >= 0 and/or y >= 0) of the grid is then kept and
+ * the rest is reconstructed when the field is evaluated. The grid must
+ * contain the mirror plane itself.
+ *
+ * Each grid point holds the three field components, i.e. 24 bytes in
+ * double and 12 bytes in single precision. A single float map therefore
+ * takes half the memory of the double map, a float map mirrored in one
+ * axis a quarter and one mirrored in both axes an eighth.
+ *
+ * Alternatively, the map can be read from a binary file written by
+ * writeBinary (e.g. with the convert-field-map executable). The binary
+ * file is memory-mapped instead of parsed, so loading it is practically
+ * instantaneous and all processes on a node using the same map share
+ * its memory. The format of the file is recognized from its contents.
+ * The binary file records the size and modification time of the text map
+ * it was converted from, so a stale conversion can be detected.
+ *
  * Original PurgMagTabulatedField3D code developed by: S.Larsson and J.
  * Generowicz.
  */
@@ -57,12 +79,55 @@ class MagneticFieldMap3D : public G4MagneticField {
    * @param[in] filename The name of the file defining the B-field grid.
    * @param[in] xOffset, yOffset, zOffset The offset of the grid's coordinate
    * system.
+   * @param[in] singlePrecision Store the grid values as floats instead of
+   * doubles, halving the memory footprint of the map. Binary maps are
+   * always used with the precision they were written with.
+   * @param[in] mirrorX, mirrorY Signs of the x, y and z field components
+   * in the mirrored half of the map (e.g. "-++"), empty if the map is not
+   * mirrored along that axis. Binary maps must be configured with the
+   * symmetries they were written with.
    */
   MagneticFieldMap3D(const char *filename, double xOffset, double yOffset,
-                     double zOffset);
+                     double zOffset, bool singlePrecision = false,
+                     const std::string &mirrorX = "",
+                     const std::string &mirrorY = "");
+
+  /**
+   * Class destructor, the binary file is unmapped by its mapping.
+   */
+  ~MagneticFieldMap3D() = default;
+
+  /// The grid may be memory-mapped, so the map can't be copied
+  MagneticFieldMap3D(const MagneticFieldMap3D &) = delete;
+  MagneticFieldMap3D &operator=(const MagneticFieldMap3D &) = delete;
+
+  /**
+   * Write the map to a binary file that can be memory-mapped.
+   *
+   * The values are written with the precision the map holds them in.
+   *
+   * @param[in] filename The name of the output file.
+   */
+  void writeBinary(const std::string &filename) const;
+
+  /**
+   * Check if a binary map is an up-to-date conversion of a text map.
+   *
+   * @param[in] binary The name of the binary file.
+   * @param[in] source The name of the text file.
+   * @return true if the binary file is a field map of the current version
+   *  whose recorded source size and modification time match the text file
+   */
+  static bool isConversionOf(const std::string &binary,
+                             const std::string &source);
 
   /**
    * Implementation of primary virtual method from G4MagneticField interface.
+   *
+   * The values at the eight corners of the grid cell containing the point
+   * are cached per thread, so consecutive calls within the same cell (which
+   * is common while integrating a single step) skip the reads of the grid.
+   *
    * @param[in]  point  The point in 3D space.
    * @param[out] bfield The output B-field data at the point.
    */
@@ -70,11 +135,104 @@ class MagneticFieldMap3D : public G4MagneticField {
 
  private:
   /*
-   * Storage space for the table.
+   * Number of values stored per grid point.
+   *
+   * The three field components are interleaved without padding, padding
+   * them to four values would cost a third more memory for no measurable
+   * gain since the corners are cached per cell anyways.
+   */
+  static const int COMPONENTS = 3;
+
+  /**
+   * Parse a field map from the text format.
+   *
+   * @param[in] filename The name of the text file.
+   * @param[in] singlePrecision Store the grid values as floats.
+   */
+  void readText(const char *filename, bool singlePrecision);
+
+  /**
+   * Memory-map a field map from the binary format.
+   *
+   * The header is validated against the size of the file and the
+   * checksum of the grid values before the map is used.
+   *
+   * @param[in] filename The name of the binary file.
+   */
+  void readBinary(const char *filename);
+
+  /**
+   * Drop the grid points outside of the fundamental region of the
+   * declared mirror symmetries.
+   */
+  void reduceToFundamentalRegion();
+
+  /**
+   * Copy the field values at the eight corners of a grid cell.
+   *
+   * The corners are ordered with the x index in the highest bit and
+   * the z index in the lowest bit.
+   *
+   * @param[in] grid The grid values
+   * @param[in] cell The flat index of the lowest corner of the cell
+   * @param[out] corners The field values at the corners
+   */
+  template <typename T>
+  void gatherCorners(const T *grid, long cell,
+                     double corners[8][COMPONENTS]) const {
+    const T *base = grid + cell * COMPONENTS;
+    for (int iCorner = 0; iCorner < 8; iCorner++) {
+      const T *value = base + cornerOffsets_[iCorner];
+      for (int iComp = 0; iComp < COMPONENTS; iComp++)
+        corners[iCorner][iComp] = value[iComp];
+    }
+  }
+
+  /*
+   * Storage space for the table, one flat interleaved grid
+   * with the z index changing fastest.
+   */
+  vector<double> grid_;
+  vector<float> gridFloat_;
+
+  /*
+   * Memory-mapped binary file, if the map was read from one.
+   *
+   * The file is unmapped when this is destroyed, which also happens if
+   * the constructor throws after the file was mapped.
+   */
+  struct Mapping {
+    Mapping() = default;
+    Mapping(const Mapping &) = delete;
+    Mapping &operator=(const Mapping &) = delete;
+    ~Mapping();
+    void *data{nullptr};
+    std::size_t size{0};
+  } mapping_;
+
+  /*
+   * Size [bytes] and modification time [s since epoch] of the text
+   * file the map was originally read from.
    */
-  vector<vector<vector<double>>> xField_;
-  vector<vector<vector<double>>> yField_;
-  vector<vector<vector<double>>> zField_;
+  std::uint64_t sourceSize_{0};
+  std::int64_t sourceModified_{0};
+
+  /*
+   * Pointer to the grid values in use (only one of them is set),
+   * either into the grid vectors or into the mapped file.
+   */
+  const double *values_{nullptr};
+  const float *valuesFloat_{nullptr};
+
+  /*
+   * Offsets of the eight corners of a cell relative to its lowest corner.
+   */
+  long cornerOffsets_[8];
+
+  /*
+   * Unique identifier of this map, used to validate the per-thread cache.
+   */
+  unsigned long id_;
 
   /*
    * The dimensions of the table.
@@ -102,6 +260,13 @@ class MagneticFieldMap3D : public G4MagneticField {
    * Flags for inverting dimensions.
    */
   bool invertX_, invertY_, invertZ_;
+
+  /*
+   * Mirror symmetries and the signs of the field components in the
+   * mirrored halves.
+   */
+  bool mirrorX_{false}, mirrorY_{false};
+  double mirrorXSigns_[3], mirrorYSigns_[3];
 };
 
 } // namespace g4fire
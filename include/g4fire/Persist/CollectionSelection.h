@@ -0,0 +1,88 @@
+#ifndef SIMCORE_PERSIST_COLLECTIONSELECTION_H_
+#define SIMCORE_PERSIST_COLLECTIONSELECTION_H_
+
+/*~~~~~~~~~~~~~~~~*/
+/*   C++ StdLib   */
+/*~~~~~~~~~~~~~~~~*/
+#include <map>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace g4fire {
+namespace persist {
+
+/**
+ * @class CollectionSelection
+ *
+ * Decides which hits collections are persisted.
+ *
+ * Two sets of rules are configured, both as lists of regular expressions
+ * that have to match the full name of a collection.
+ * <ul>
+ * <li>Collections matching a <i>drop</i> pattern are never persisted.
+ * Since nobody will ever look at their hits, their sensitive detectors
+ * are deactivated as well so that no hits are created for them.</li>
+ * <li>Collections matching a <i>keep if filtered</i> pattern are only
+ * persisted for events that were marked as passing a filter in the
+ * UserEventInformation.</li>
+ * </ul>
+ * Collections not matching any pattern are always persisted.
+ */
+class CollectionSelection {
+ public:
+  /**
+   * Constructor
+   *
+   * @param[in] drop patterns of collections to always drop
+   * @param[in] keep_if_filtered patterns of collections to only keep for
+   *  events that passed a filter
+   */
+  CollectionSelection(const std::vector<std::string> &drop = {},
+                      const std::vector<std::string> &keep_if_filtered = {});
+
+  /**
+   * Check if a collection is always dropped
+   *
+   * @param[in] name name of the collection
+   * @return true if the collection matches one of the drop patterns
+   */
+  bool isDropped(const std::string &name) const;
+
+  /**
+   * Check if a collection should be persisted for the current event
+   *
+   * @param[in] name name of the collection
+   * @param[in] passed_filter true if the current event passed a filter
+   * @return true if the collection should be persisted
+   */
+  bool keep(const std::string &name, bool passed_filter) const;
+
+ private:
+  /// What to do with a collection
+  enum class Decision { keep, drop, keep_if_filtered };
+
+  /**
+   * Look up the decision for a collection, matching the patterns
+   * only the first time we encounter its name.
+   *
+   * @param[in] name name of the collection
+   * @return decision for this collection
+   */
+  Decision decide(const std::string &name) const;
+
+ private:
+  /// Patterns of collections to always drop
+  std::vector<std::regex> drop_;
+
+  /// Patterns of collections to keep only for filtered events
+  std::vector<std::regex> keep_if_filtered_;
+
+  /// Cache of the decisions that have already been made
+  mutable std::map<std::string, Decision> decisions_;
+};
+
+}  // namespace persist
+}  // namespace g4fire
+
+#endif
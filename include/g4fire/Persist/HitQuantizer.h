@@ -0,0 +1,130 @@
+#ifndef SIMCORE_PERSIST_HITQUANTIZER_H_
+#define SIMCORE_PERSIST_HITQUANTIZER_H_
+
+/*~~~~~~~~~~~~~~~~*/
+/*   C++ StdLib   */
+/*~~~~~~~~~~~~~~~~*/
+#include <string>
+#include <vector>
+
+/*~~~~~~~~~~~~~~~*/
+/*   Framework   */
+/*~~~~~~~~~~~~~~~*/
+#include "Framework/Configure/Parameters.h"
+#include "Framework/Event.h"
+#include "Framework/RunHeader.h"
+
+/*~~~~~~~~~~~~~*/
+/*   g4fire   */
+/*~~~~~~~~~~~~~*/
+#include "g4fire/Event/SimCalorimeterHit.h"
+#include "g4fire/Event/SimHitColumns.h"
+#include "g4fire/Event/SimTrackerHit.h"
+
+namespace g4fire {
+namespace persist {
+
+/**
+ * @class HitQuantizer
+ *
+ * Stores the kinematic fields of a single sim hit collection with reduced
+ * precision.
+ *
+ * The low bits of the simulated floats are below the detector resolution
+ * anyways, so the fields are encoded into narrower codes and the
+ * collection is added to the event in a quantized columnar layout
+ * (see ldmx::QuantizedSimTrackerHitColumns) instead of as floats.
+ * Two modes are supported.
+ *
+ * <b>fixed</b>: Each field is stored as a 32-bit integer counting
+ * multiples of its configured step size. The absolute precision loss of
+ * a field is at most half of its step. The uncompressed size is the same
+ * as for floats, but the codes only use the bits needed for the range of
+ * the field and compress far better. A step of zero (or less) stores
+ * the raw bits of the float, leaving that field untouched.
+ *
+ * <b>float16</b>: Each field is stored as a 16-bit IEEE half-precision
+ * float, halving its uncompressed size. The relative precision loss is
+ * at most 2^-11 (about 0.05%) and values beyond 65504 saturate, so this
+ * mode is only suited for fields in MeV, mm and ns that stay below that.
+ * The step sizes are ignored in this mode.
+ *
+ * IDs, track IDs and PDG codes are never modified.
+ */
+class HitQuantizer {
+ public:
+  /// The supported quantization modes
+  enum class Mode { fixed, float16 };
+
+  /**
+   * Configure the quantizer.
+   *
+   * @param[in] parameters configuration of the quantization for one
+   *  collection, i.e. the name of the collection, the mode and the
+   *  step sizes of each field
+   */
+  HitQuantizer(const framework::config::Parameters &parameters);
+
+  /// Destructor
+  ~HitQuantizer() = default;
+
+  /**
+   * @return name of the collection this quantizer applies to
+   */
+  const std::string &getCollectionName() const { return collection_; }
+
+  /**
+   * Encode a collection of tracker hits and add it to the event.
+   *
+   * @param[in] hits collection to encode
+   * @param[in] event event to add the quantized columns to
+   */
+  void add(const std::vector<ldmx::SimTrackerHit> &hits,
+           framework::Event &event) const;
+
+  /**
+   * Encode a collection of calorimeter hits and add it to the event.
+   *
+   * The contributions are encoded with the same step sizes as
+   * the hit itself.
+   *
+   * @param[in] hits collection to encode
+   * @param[in] event event to add the quantized columns to
+   */
+  void add(const std::vector<ldmx::SimCalorimeterHit> &hits,
+           framework::Event &event) const;
+
+  /**
+   * Record the mode and step sizes of this collection in the run header.
+   *
+   * @param[in] header run header to write to
+   */
+  void record(ldmx::RunHeader &header) const;
+
+ private:
+  /**
+   * Encode a collection into its quantized columns and add them.
+   *
+   * @tparam Columns quantized columnar layout of the collection
+   * @tparam Hit type of hit in the collection
+   * @param[in] hits collection to encode
+   * @param[in] event event to add the quantized columns to
+   */
+  template <typename Columns, typename Hit>
+  void add(const std::vector<Hit> &hits, framework::Event &event) const;
+
+ private:
+  /// Name of the collection to quantize
+  std::string collection_;
+
+  /// Quantization mode
+  Mode mode_{Mode::fixed};
+
+  /// Step sizes of the fixed-point fields
+  ldmx::QuantizationSteps steps_;
+};
+
+}  // namespace persist
+}  // namespace g4fire
+
+#endif
@@ -4,6 +4,7 @@
 /*~~~~~~~~~~~~~~~~*/
 /*   C++ StdLib   */
 /*~~~~~~~~~~~~~~~~*/
+#include <map>
 #include <string>
 #include <vector>
 
@@ -11,14 +12,18 @@
 /*   Framework   */
 /*~~~~~~~~~~~~~~~*/
 #include "Framework/Configure/Parameters.h"
+#include "Framework/Event.h"
 #include "Framework/EventFile.h"
 
 /*~~~~~~~~~~~~~*/
 /*   g4fire   */
 /*~~~~~~~~~~~~~*/
 #include "g4fire/EcalHitIO.h"
+#include "g4fire/Event/SimHitColumns.h"
 #include "g4fire/G4CalorimeterHit.h"
 #include "g4fire/G4TrackerHit.h"
+#include "g4fire/Persist/CollectionSelection.h"
+#include "g4fire/Persist/HitQuantizer.h"
 
 /*~~~~~~~~~~~~*/
 /*   Geant4   */
@@ -92,6 +97,10 @@ class RootPersistencyManager : public G4PersistencyManager {
    * This gets called automatically at the end of the run and is used to write
    * out the run header and close the writer.
    *
+   * The biasing factors chosen during a warm-up are recorded here since
+   * they are not known when the run starts, along with the step sizes of
+   * the quantized hits collections.
+   *
    * @param aRun The Geant4 run data (not used right now)
    *
    * @return True if event is stored (function is hard-coded to return true).
@@ -182,6 +191,39 @@ class RootPersistencyManager : public G4PersistencyManager {
       std::vector<ldmx::SimCalorimeterHit> &outputColl);
 
  private:
+  /**
+   * Add a converted collection of hits to the output event.
+   *
+   * If a quantization is configured for this collection, the hits are
+   * encoded into their quantized columnar layout and that is added to
+   * the event, regardless of whether the columnar layout is enabled.
+   *
+   * Otherwise, if the columnar layout is enabled, the hits are copied
+   * into their columnar counterpart (one array per field) and that is
+   * added to the event instead.
+   *
+   * @tparam Columns The columnar layout of the collection
+   * @tparam Hit The type of hit in the collection
+   * @param collName name of the collection in the output event
+   * @param outputColl The converted collection of hits
+   * @param outputEvent The output event
+   */
+  template <typename Columns, typename Hit>
+  void addCollection(const std::string &collName,
+                     std::vector<Hit> &outputColl,
+                     framework::Event *outputEvent) {
+    auto quantizer{quantizers_.find(collName)};
+    if (quantizer != quantizers_.end()) {
+      quantizer->second.add(outputColl, *outputEvent);
+    } else if (columnarOutput_) {
+      Columns columns;
+      columns.fill(outputColl);
+      outputEvent->add(collName, columns);
+    } else {
+      outputEvent->add(collName, outputColl);
+    }
+  }
+
   /// Configuration parameters passed to Simulator
   framework::config::Parameters parameters_;
 
@@ -202,6 +244,15 @@ class RootPersistencyManager : public G4PersistencyManager {
 
   /// Handles ECal hit readout and IO.
   EcalHitIO ecalHitIO_;
+
+  /// Write the hits collections in a columnar (flat-array) layout
+  bool columnarOutput_{false};
+
+  /// Which hits collections to persist
+  CollectionSelection selection_;
+
+  /// Quantization applied to a hits collection, keyed by collection name
+  std::map<std::string, HitQuantizer> quantizers_;
 };
 
 }  // namespace persist
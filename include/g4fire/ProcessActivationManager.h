@@ -0,0 +1,68 @@
+#ifndef G4FIRE_PROCESSACTIVATIONMANAGER_H
+#define G4FIRE_PROCESSACTIVATIONMANAGER_H
+
+#include <map>
+#include <utility>
+#include <vector>
+
+class G4ParticleDefinition;
+class G4ProcessManager;
+class G4VProcess;
+
+namespace g4fire {
+
+/**
+ * Switches processes off for the rest of an event.
+ *
+ * A process is resolved once per run into the process managers and indices
+ * of itself and of any biasing wrapper around it, so switching it off or on
+ * during the event is a direct call on the cached process managers instead
+ * of a lookup by name in the G4ProcessTable. Every process switched off
+ * during an event is switched back on by reactivate at the end of it.
+ */
+class ProcessActivationManager {
+ public:
+  /// @return the single instance of the manager
+  static ProcessActivationManager &getInstance();
+
+  /**
+   * Find a process and any biasing wrapper of it in the process manager of
+   * a particle.
+   *
+   * Should be called when the physics tables are built, after all
+   * processes and biasing wrappers are attached. Resolving again for the
+   * same particle replaces the previous entries.
+   *
+   * @param[in] process the process to resolve
+   * @param[in] particle the particle the process is attached to
+   */
+  void resolve(const G4VProcess *process, const G4ParticleDefinition &particle);
+
+  /**
+   * Switch a resolved process (and its biasing wrapper) off until the end
+   * of the event.
+   *
+   * @param[in] process the process to switch off
+   */
+  void deactivate(const G4VProcess *process);
+
+  /// Switch the processes switched off during this event back on
+  void reactivate();
+
+ private:
+  /// Only accessible through getInstance
+  ProcessActivationManager() = default;
+
+  /// A process vector entry: the manager and the index of the process in it
+  typedef std::pair<G4ProcessManager *, int> Entry;
+
+  /// The process vector entries of each resolved process
+  std::map<const G4VProcess *, std::vector<Entry>> entries_;
+
+  /// The entries switched off during this event
+  std::vector<Entry> deactivated_;
+};
+
+}  // namespace g4fire
+
+#endif  // G4FIRE_PROCESSACTIVATIONMANAGER_H
@@ -0,0 +1,107 @@
+#ifndef G4FIRE_READOUTFILTER_H
+#define G4FIRE_READOUTFILTER_H
+
+#include <limits>
+#include <unordered_map>
+
+#include "G4Step.hh"
+#include "G4THitsCollection.hh"
+#include "G4Track.hh"
+
+namespace g4fire {
+
+/**
+ * Emulation of the readout of a sensitive detector.
+ *
+ * Deposits that could never survive digitization are removed as early
+ * as possible so they are neither kept in memory nor written out.
+ *
+ * <ul>
+ * <li>Steps outside of the readout time window are rejected before a hit
+ * is created for them.</li>
+ * <li>At the end of the event, the hits are aggregated by their
+ * detector ID and all hits of a cell whose total energy deposition is
+ * below the zero-suppression threshold are removed.</li>
+ * </ul>
+ *
+ * Sensitive detectors inherit from this class in order to be
+ * configurable. By default, the window is infinite and the threshold
+ * is zero so nothing is removed.
+ */
+class ReadoutFilter {
+ public:
+  /// Destructor
+  virtual ~ReadoutFilter() = default;
+
+  /**
+   * Set the readout time window.
+   *
+   * @param[in] min_time start of the window (global time) [ns]
+   * @param[in] max_time end of the window (global time) [ns]
+   */
+  void setReadoutWindow(double min_time, double max_time) {
+    min_time_ = min_time;
+    max_time_ = max_time;
+  }
+
+  /**
+   * Set the zero-suppression threshold.
+   *
+   * @param[in] threshold minimum energy deposited in a cell for its
+   *  hits to be kept [MeV]
+   */
+  void setEnergyThreshold(double threshold) { threshold_ = threshold; }
+
+ protected:
+  /**
+   * Check if the input step is within the readout window.
+   *
+   * The global time of the track is used since that is the time
+   * assigned to the hits.
+   *
+   * @param[in] step step to check
+   * @return true if the step is within the window
+   */
+  bool isInReadoutWindow(const G4Step *step) const {
+    auto time{step->GetTrack()->GetGlobalTime()};
+    return time >= min_time_ and time <= max_time_;
+  }
+
+  /**
+   * Remove the hits of all cells whose total energy deposition is below
+   * the zero-suppression threshold.
+   *
+   * @param[in,out] hits collection of hits to suppress
+   */
+  template <typename Hit>
+  void suppress(G4THitsCollection<Hit> *hits) const {
+    if (threshold_ <= 0. or hits == nullptr) return;
+
+    std::unordered_map<int, double> cell_edep;
+    auto vec{hits->GetVector()};
+    for (auto hit : *vec) cell_edep[hit->getID()] += hit->getEdep();
+
+    auto kept{vec->begin()};
+    for (auto hit : *vec) {
+      if (cell_edep[hit->getID()] < threshold_)
+        delete hit;
+      else
+        *kept++ = hit;
+    }
+    vec->erase(kept, vec->end());
+  }
+
+ private:
+  /// Start of the readout window [ns]
+  double min_time_{-std::numeric_limits<double>::max()};
+
+  /// End of the readout window [ns]
+  double max_time_{std::numeric_limits<double>::max()};
+
+  /// Zero-suppression threshold on the energy in a cell [MeV]
+  double threshold_{0.};
+};
+
+}  // namespace g4fire
+
+#endif  // G4FIRE_READOUTFILTER_H
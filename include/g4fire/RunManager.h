@@ -2,6 +2,7 @@
 
 #include <any>
 #include <map>
+#include <memory>
 #include <string>
 
 #include "G4PhysListFactory.hh"
@@ -11,8 +12,10 @@
 
 namespace g4fire {
 
+class AnalyticScoringPlanes;
 class ConditionsInterface;
 class DetectorConstruction;
+class LooperPolicy;
 //class UserActionManager;
 //class APrimeMessenger;
 
@@ -23,7 +26,7 @@ class RunManager : public G4RunManager {
   RunManager(const fire::config::Parameters& params, ConditionsInterface& ci);
 
   /// Destructor
-  ~RunManager() = default;
+  ~RunManager();
 
   /**
    * Initialize physics.
@@ -38,12 +41,32 @@ class RunManager : public G4RunManager {
   /**
    * Called at the end of each event.
    *
-   * Runs parent process G4RunManager::TerminateOneEvent() and
-   * resets the activation for the G4eDarkBremsstrahlung process
-   * (if dark brem is possible)
+   * Adds the loopers killed in the event to the run totals, runs parent
+   * process G4RunManager::TerminateOneEvent() and re-activates the
+   * processes that were deactivated during the event through the
+   * ProcessActivationManager (e.g. G4eDarkBremsstrahlung)
    */
   void TerminateOneEvent();
 
+  /**
+   * Start a new run.
+   *
+   * Runs parent process G4RunManager::RunInitialization() and resets the
+   * run totals of the killed loopers.
+   */
+  void RunInitialization();
+
+  /**
+   * @returns number of tracks killed for looping in all events of the run
+   */
+  int getLoopingTracksKilled() const { return looping_tracks_killed_; }
+
+  /**
+   * @returns kinetic energy of the tracks killed for looping in all events
+   *  of the run [MeV]
+   */
+  double getLoopingEnergyKilled() const { return looping_energy_killed_; }
+
   /**
    * Get the user detector construction cast to a specific type.
    * @return The user detector construction.
@@ -61,6 +84,33 @@ class RunManager : public G4RunManager {
   //bool useRootSeed() { return useRootSeed_; }
 
  private:
+  /**
+   * Deactivate the sensitive detectors whose hits collections are
+   * all configured to be dropped from the output.
+   *
+   * This needs to be called after the sensitive detectors have been
+   * constructed i.e. after G4RunManager::Initialize.
+   */
+  void deactivateDroppedCollections();
+
+  /**
+   * Configure the readout time windows and zero-suppression thresholds
+   * of the sensitive detectors.
+   *
+   * This needs to be called after the sensitive detectors have been
+   * constructed i.e. after G4RunManager::Initialize.
+   */
+  void configureReadoutFilters();
+
+  /**
+   * Configure the particle selection and deduplication of the crossings
+   * recorded by the scoring planes.
+   *
+   * This needs to be called after the parallel world sensitive detectors
+   * have been constructed i.e. after G4RunManager::Initialize.
+   */
+  void configureCrossingFilters();
+
   /// The set of parameters used to configure the RunManager
   fire::config::Parameters params_;
 
@@ -78,6 +128,24 @@ class RunManager : public G4RunManager {
   /** Path to GDML description of parallel world. */
   std::string parallel_world_path_{""};
 
+  /**
+   * Find the scoring plane crossings analytically in the stepping action
+   * instead of loading the scoring planes into a parallel world.
+   */
+  bool analytic_scoring_planes_{false};
+
+  /// The scoring planes handled analytically
+  std::unique_ptr<AnalyticScoringPlanes> scoring_planes_;
+
+  /// The policy for killing particles looping in a field
+  std::unique_ptr<LooperPolicy> looper_policy_;
+
+  /// Number of tracks killed for looping in the events of this run
+  int looping_tracks_killed_{0};
+
+  /// Kinetic energy of the tracks killed for looping in this run [MeV]
+  double looping_energy_killed_{0.};
+
   /**
    * Should we use random seed from root file?
    */
@@ -14,6 +14,7 @@
 /*~~~~~~~~~~~~~~~~~~~~*/
 /*   g4fire   */
 /*~~~~~~~~~~~~~~~~~~~~*/
+#include "g4fire/CrossingFilter.h"
 #include "g4fire/G4TrackerHit.h"
 
 // Forward declaration
@@ -23,8 +24,14 @@ namespace g4fire {
 
 /**
  * Class defining a basic sensitive detector for scoring planes.
+ *
+ * By default, a hit is created for every step inside of a plane.
+ * If only the first crossing of a track is recorded, the single hit
+ * of a track holds the position, time and momentum at which the track
+ * entered the plane, so the momentum also gives the direction in which
+ * the plane was crossed.
  */
-class ScoringPlaneSD : public G4VSensitiveDetector {
+class ScoringPlaneSD : public G4VSensitiveDetector, public CrossingFilter {
  public:
   /**
    * Constructor
@@ -46,6 +53,22 @@ class ScoringPlaneSD : public G4VSensitiveDetector {
    */
   G4bool ProcessHits(G4Step* step, G4TouchableHistory* history);
 
+  /**
+   * Create a hit from a crossing of a plane found analytically.
+   *
+   * The time, momentum and energy of the hit are interpolated between
+   * the two step points. The magnitude of the momentum and its direction
+   * are interpolated separately, so a track curving in a field keeps its
+   * momentum magnitude at the crossing.
+   *
+   * @param step The step during which the plane was crossed.
+   * @param position The position of the crossing.
+   * @param fraction The fraction of the step before the crossing.
+   * @param plane The copy number of the crossed plane.
+   */
+  void recordCrossing(const G4Step* step, const G4ThreeVector& position,
+                      double fraction, int plane) final override;
+
   /**
    * Initialize the sensitive detector.
    *
@@ -109,6 +109,15 @@ private:
    */
   bool allowed(const std::string &command) const;
 
+  /**
+   * Update the header of the current run with what is only known once
+   * events were simulated, i.e. the looper totals and the tuned factors.
+   *
+   * Called after every event, started or completed, so the header holds
+   * the values of the whole run once fire writes it.
+   */
+  void updateRunHeader();
+
   /**
    * Set the seeds to be used by the Geant4 random engine.
    *
@@ -135,6 +144,9 @@ private:
   ///     This is because Simulator already runs them.
   static const std::vector<std::string> invalid_cmds;
 
+  /// Header of the current run, written by fire once the run is over
+  fire::RunHeader *run_header_{nullptr};
+
   /// Number of events started
   int n_events_began_{0};
 
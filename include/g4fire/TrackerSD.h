@@ -15,6 +15,7 @@
 /*   g4fire   */
 /*~~~~~~~~~~~~~~~~~~~~*/
 #include "g4fire/G4TrackerHit.h"
+#include "g4fire/ReadoutFilter.h"
 
 namespace g4fire {
 
@@ -23,9 +24,11 @@ namespace g4fire {
  * @brief Basic sensitive detector for trackers
  *
  * @note
- * This class creates a G4TrackerHit for each step within the subdetector.
+ * This class creates a G4TrackerHit for each step within the subdetector
+ * and the readout window. Hits in sensors below the zero-suppression
+ * threshold are removed at the end of the event.
  */
-class TrackerSD : public G4VSensitiveDetector {
+class TrackerSD : public G4VSensitiveDetector, public ReadoutFilter {
  public:
   /**
    * Class constructor.
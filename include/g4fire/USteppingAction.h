@@ -5,6 +5,8 @@
 
 #include "G4UserSteppingAction.hh"
 
+#include "g4fire/AnalyticScoringPlanes.h"
+#include "g4fire/LooperPolicy.h"
 #include "g4fire/UserAction.h"
 
 namespace g4fire {
@@ -33,10 +35,35 @@ class USteppingAction : public G4UserSteppingAction {
     stepping_actions_.push_back(stepping_action);
   }
 
+  /**
+   * Set the scoring planes whose crossings are found in the
+   * stepping action.
+   *
+   * @param scoring_planes Analytic scoring planes, owned by the caller
+   */
+  void setScoringPlanes(AnalyticScoringPlanes *scoring_planes) {
+    scoring_planes_ = scoring_planes;
+  }
+
+  /**
+   * Set the policy used to kill particles looping in a field.
+   *
+   * @param looper_policy Looper policy, owned by the caller
+   */
+  void setLooperPolicy(LooperPolicy *looper_policy) {
+    looper_policy_ = looper_policy;
+  }
+
  private:
   /// Collection of user stepping actions
   std::vector<UserAction *> stepping_actions_;
 
+  /// Scoring planes handled analytically, if enabled
+  AnalyticScoringPlanes *scoring_planes_{nullptr};
+
+  /// Policy for killing loopers, if enabled
+  LooperPolicy *looper_policy_{nullptr};
+
 }; // USteppingAction
 } // namespace g4fire
 
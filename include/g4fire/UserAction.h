@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "G4EventManager.hh"
+#include "G4RunManager.hh"
 #include "G4UserStackingAction.hh"
 
 #include "fire/config/Parameters.h"
@@ -167,6 +168,26 @@ class UserAction {
         G4EventManager::GetEventManager()->GetUserInformation());
   }
 
+  /**
+   * Mark the current event as passing this filter.
+   *
+   * Filters call this once the event satisfies their criteria. Collections
+   * configured with keep_collections_if_filtered are only persisted for
+   * events that were marked.
+   */
+  static void passEvent() { getEventInfo()->setPassedFilter(true); }
+
+  /**
+   * Reject the current event.
+   *
+   * The event is aborted, so none of its collections are persisted,
+   * even if another filter marked it as passing before.
+   */
+  static void rejectEvent() {
+    getEventInfo()->setPassedFilter(false);
+    G4RunManager::GetRunManager()->AbortEvent();
+  }
+
  protected:
   /// Name of the UserAction
   std::string name_{""};
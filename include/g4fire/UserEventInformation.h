@@ -1,6 +1,9 @@
 #ifndef G4FIRE_USEREVENTINFORMATION_H
 #define G4FIRE_USEREVENTINFORMATION_H
 
+#include <map>
+#include <vector>
+
 #include "G4VUserEventInformation.hh"
 
 namespace g4fire {
@@ -102,6 +105,86 @@ class UserEventInformation : public G4VUserEventInformation {
    */
   bool wasLastStepEN() const { return last_step_en_; }
 
+  /**
+   * Count a track killed for looping in a field.
+   *
+   * @param[in] energy kinetic energy the track carried [MeV]
+   */
+  void addKilledLooper(double energy) {
+    looping_tracks_killed_ += 1;
+    looping_energy_killed_ += energy;
+  }
+
+  /**
+   * @returns number of tracks killed for looping in this event
+   */
+  int getLoopingTracksKilled() const { return looping_tracks_killed_; }
+
+  /**
+   * @returns total kinetic energy of the tracks killed for looping [MeV]
+   */
+  double getLoopingEnergyKilled() const { return looping_energy_killed_; }
+
+  /**
+   * @struct DarkBrem
+   *
+   * What happened in a dark brem, as needed to reweight it.
+   */
+  struct DarkBrem {
+    /// kinetic energy of the incident electron [MeV]
+    double incident_energy;
+    /// atomic mass of the element the dark brem happened on
+    double atomic_a;
+    /// atomic number of the element the dark brem happened on
+    double atomic_z;
+    /// total energy of the A' [MeV]
+    double aprime_energy;
+  };
+
+  /**
+   * Record a dark brem and fold its weights for other A' masses into the
+   * weights of the event.
+   *
+   * @param[in] dark_brem the dark brem
+   * @param[in] mass_weights cross section of each other A' mass [MeV]
+   *  relative to the simulated one for this dark brem
+   */
+  void addDarkBrem(const DarkBrem &dark_brem,
+                   const std::map<double, double> &mass_weights) {
+    dark_brems_.push_back(dark_brem);
+    for (const auto &[mass, weight] : mass_weights)
+      mass_weights_.emplace(mass, 1.).first->second *= weight;
+  }
+
+  /**
+   * @returns the recorded dark brems of this event
+   */
+  const std::vector<DarkBrem> &getDarkBrems() const { return dark_brems_; }
+
+  /**
+   * @returns weight of this event for each other A' mass [MeV]
+   */
+  const std::map<double, double> &getMassWeights() const {
+    return mass_weights_;
+  }
+
+  /**
+   * Mark this event as passing a filter.
+   *
+   * Collections configured to only be kept for filtered events
+   * are persisted only if this was set. Filters set this through
+   * UserAction::passEvent.
+   *
+   * @param[in] yes true if the event passed
+   */
+  void setPassedFilter(bool yes) { passed_filter_ = yes; }
+
+  /**
+   * Did this event pass a filter?
+   * @returns true if it did
+   */
+  bool passedFilter() const { return passed_filter_; }
+
  private:
   /// Total number of brem candidates in the event
   int brem_candidate_count_{0};
@@ -142,6 +225,23 @@ class UserEventInformation : public G4VUserEventInformation {
    * Was the most recent step a electron-nuclear interaction?
    */
   bool last_step_en_{false};
+
+  /**
+   * Did this event pass a filter?
+   */
+  bool passed_filter_{false};
+
+  /// Number of tracks killed for looping in a field
+  int looping_tracks_killed_{0};
+
+  /// Total kinetic energy of the tracks killed for looping [MeV]
+  double looping_energy_killed_{0.};
+
+  /// Dark brems recorded for reweighting
+  std::vector<DarkBrem> dark_brems_;
+
+  /// Event weight for each other A' mass [MeV]
+  std::map<double, double> mass_weights_;
 };
 } // namespace g4fire
 
@@ -100,6 +100,55 @@ class UserTrackInformation : public G4VUserTrackInformation {
    */
   void tagPNGamma(bool is_pn_gamma = true) { is_pn_gamma_ = is_pn_gamma; }
 
+  /**
+   * Count another consecutive looping step of this track.
+   *
+   * @return The number of consecutive looping steps including this one.
+   */
+  int incLoopingSteps() { return ++looping_steps_; }
+
+  /// Reset the count of consecutive looping steps.
+  void resetLoopingSteps() { looping_steps_ = 0; }
+
+  /**
+   * Get the part of the track weight that is already included in the
+   * event weight.
+   *
+   * The stepping action folds every change of a track weight into the
+   * event weight, secondaries start with the folded weight of their parent
+   * and primaries with the weight of their vertex.
+   *
+   * @return The folded weight.
+   */
+  double getFoldedWeight() const { return folded_weight_; }
+
+  /**
+   * Set the part of the track weight that is already included in the
+   * event weight.
+   *
+   * @param folded_weight The folded weight.
+   */
+  void setFoldedWeight(double folded_weight) { folded_weight_ = folded_weight; }
+
+  /**
+   * Fold a change of the track weight into the folded weight.
+   *
+   * @param weight Ratio of the track weight after and before a step.
+   */
+  void foldWeight(double weight) { folded_weight_ *= weight; }
+
+  /**
+   * Get the weight the hits of a track carry on top of the event weight.
+   *
+   * This is the track weight divided by the part of it that is already
+   * included in the event weight, e.g. 1/N for the N split copies of a
+   * secondary whose parent had its occurence biased.
+   *
+   * @param track G4Track to get the weight of
+   * @return The weight of the hits made by the track.
+   */
+  static double getHitWeight(const G4Track* track);
+
   /**
    * Get the initial momentum 3-vector of the track [MeV].
    *
@@ -136,6 +185,12 @@ class UserTrackInformation : public G4VUserTrackInformation {
    */
   bool is_pn_gamma_{false};
 
+  /// Number of consecutive steps this track was looping in a field.
+  int looping_steps_{0};
+
+  /// Part of the track weight that is already in the event weight.
+  double folded_weight_{1.};
+
   /// Volume the track was created in.
   std::string vertex_volume_{""};
 
@@ -1,8 +1,12 @@
 #ifndef G4FIRE_XSECBIASINGOPERATOR_H_
 #define G4FIRE_XSECBIASINGOPERATOR_H_
 
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "fire/RunHeader.h"
 #include "fire/config/Parameters.h"
-//#include "Framework/RunHeader.h"
 
 #include "G4BOptnChangeCrossSection.hh"
 #include "G4BiasingProcessInterface.hh"
@@ -47,11 +51,17 @@ class XsecBiasingOperator : public G4VBiasingOperator {
    * and are given the configuration params loaded from the
    * python script.
    *
+   * The 'factor' is required unless 'adaptive_factors' are given or
+   * the derived class doesn't need it.
+   *
    * @param name unique instance name for this biasing operator
    * @param params python configuration parameters
+   * @param factor_required false for operators that don't bias by a
+   *  factor or where it is optional (default 1)
    */
   XsecBiasingOperator(std::string name,
-                      const fire::config::Parameters& params);
+                      const fire::config::Parameters& params,
+                      bool factor_required = true);
 
   /// Destructor 
   virtual ~XsecBiasingOperator();
@@ -87,6 +97,8 @@ class XsecBiasingOperator : public G4VBiasingOperator {
    *
    * This makes sure that the process we want to bias can
    * be biased and constructs a corresponding biasing operation.
+   * The biased process is resolved into biased_process_ here so
+   * that the per-step checks are pointer comparisons.
    *
    * It can be over-written, but then the derived class should
    * call `XsecBiasingOperator::StartRun()` at the beginning of
@@ -111,6 +123,18 @@ class XsecBiasingOperator : public G4VBiasingOperator {
    */
   virtual std::string getParticleToBias() const = 0;
 
+  /**
+   * Return the particles which should be biased.
+   *
+   * Operators biasing a process act on the particle the process is
+   * attached to, operators that don't bias a process (e.g. weight
+   * windows) may act on several particles.
+   * @see RunManager::setupPhysics
+   */
+  virtual std::vector<std::string> getParticlesToBias() const {
+    return {getParticleToBias()};
+  }
+
   /**
    * Return the volume which should be biased.
    *
@@ -120,13 +144,30 @@ class XsecBiasingOperator : public G4VBiasingOperator {
    */
   virtual std::string getVolumeToBias() const = 0;
 
+  /**
+   * Return the factor the cross section of the process is biased by.
+   *
+   * If factors are being tuned, this is the factor chosen once the
+   * warm-up is over.
+   */
+  double getFactor() const { return factor_; }
+
+  /**
+   * Check if the factor was chosen during a warm-up phase.
+   *
+   * @return true if the warm-up of the adaptive factors is over
+   */
+  bool isFactorTuned() const { return factor_tuned_; }
+
   /**
    * Record the configuration of this
    * biasing operator into the run header.
    *
+   * Nothing is recorded unless the derived class overrides it.
+   *
    * @param[in,out] header RunHeader to write configuration to
    */
-  //virtual void RecordConfig(ldmx::RunHeader& header) const = 0;
+  virtual void RecordConfig(fire::RunHeader& header) const {}
 
  protected:
   /**
@@ -155,11 +196,99 @@ class XsecBiasingOperator : public G4VBiasingOperator {
    * @param process Process of interest
    * @return true if the process is being biased, false otherwise
    */
-  bool processIsBiased(std::string process);
+  bool processIsBiased(std::string process) {
+    return findBiasedProcess(process) != nullptr;
+  }
+
+  /**
+   * Find the process wrapped by a biasing wrapper of the particle
+   * to bias.
+   *
+   * The wrapped process pointers are stable for the whole run, so
+   * the derived classes resolve the processes they act on in StartRun
+   * and compare the calling process to them with isCalledBy.
+   *
+   * @param process name of the process of interest
+   * @return the wrapped process, nullptr if the process isn't biased
+   */
+  const G4VProcess* findBiasedProcess(const std::string& process) const;
+
+  /**
+   * Check if the calling process wraps the given process.
+   *
+   * @param calling_process biasing wrapper asking to be biased
+   * @param process process resolved in StartRun
+   * @return true if the calling process wraps process
+   */
+  static bool isCalledBy(const G4BiasingProcessInterface* calling_process,
+                         const G4VProcess* process) {
+    return process and calling_process->GetWrappedProcess() == process;
+  }
+
+  /// The process whose cross-section is biased, resolved in StartRun.
+  const G4VProcess* biased_process_{nullptr};
+
+  /**
+   * Update the factor while tuning it.
+   *
+   * If 'adaptive_factors' are configured, each of them is used for
+   * 'warm_up_events' events at the start of the run, counted from the
+   * first event of the run whatever its ID. Each event is scored by the
+   * sum of the weights of the occurences of the biased process in it. Once all factors have been tried, the one with the
+   * largest figure of merit
+   *
+   *    mean(score)^2 / ( variance(score) * time )
+   *
+   * is kept for the rest of the run. Since the events are weighted
+   * correctly whatever the factor, the warm-up events are not wasted.
+   *
+   * Derived classes biasing by factor_ call this before using it.
+   */
+  void tuneFactor();
+
+  /**
+   * Check if the factor is being tuned.
+   *
+   * @return true during the warm-up of the adaptive factors
+   */
+  bool isTuningFactor() const {
+    return !candidates_.empty() and !factor_tuned_;
+  }
+
+  /**
+   * Exclude the factor being tried from the choice.
+   *
+   * Called when the factor is found to be too large for the biasing
+   * to be correct, e.g. when a down-biased process would need a
+   * negative cross section.
+   */
+  void rejectFactor();
+
+  /**
+   * Score the occurences of the biased process while tuning the factor.
+   *
+   * This is called inside G4VBiasingOperator::ReportOperationApplied
+   * which is called inside G4BiasingProcessInterface::PostStepDoIt
+   */
+  void OperationApplied(const G4BiasingProcessInterface* calling_process,
+                        G4BiasingAppliedCase biasing_case,
+                        G4VBiasingOperation* occurence_operation_applied,
+                        G4double weight_for_occurence_interaction,
+                        G4VBiasingOperation* final_state_operation_applied,
+                        const G4VParticleChange* particle_change_produced)
+      override;
+  using G4VBiasingOperator::OperationApplied;
 
   /// Cross-section biasing operation.
   G4BOptnChangeCrossSection* xsec_operation_{nullptr};
 
+  /**
+   * Factor to bias the cross-section by.
+   *
+   * Configurable with 'factor', or tuned with 'adaptive_factors'.
+   */
+  double factor_{1.};
+
   /// Process manager associated with the particle of interest. 
   G4ProcessManager* process_manager_{nullptr};
 
@@ -175,6 +304,48 @@ class XsecBiasingOperator : public G4VBiasingOperator {
     return nullptr;
   }
 
+ private:
+  /// A factor tried during the warm-up and how it performed.
+  struct Candidate {
+    /// the factor
+    double factor;
+    /// sum of the scores of the events
+    double sum_score{0.};
+    /// sum of the squares of the scores of the events
+    double sum_score2{0.};
+    /// time spent on the events [s]
+    double seconds{0.};
+    /// was the factor found to be too large?
+    bool rejected{false};
+  };
+
+  /// Choose the factor with the largest figure of merit.
+  void chooseFactor();
+
+  /// Factors to try, empty if the factor isn't tuned.
+  std::vector<Candidate> candidates_;
+
+  /// Number of events to try each factor for.
+  int warm_up_events_{100};
+
+  /// Factor configured for the operator, kept if no factor scores.
+  double configured_factor_{1.};
+
+  /// Index of the factor being tried.
+  std::size_t phase_{0};
+
+  /// ID of the event being scored, -1 before the first one.
+  int current_event_{-1};
+
+  /// Score of the event so far.
+  double current_score_{0.};
+
+  /// When the factor being tried started being used.
+  std::chrono::steady_clock::time_point phase_start_;
+
+  /// Is the warm-up over?
+  bool factor_tuned_{false};
+
 }; // XsecBiasingOperator
 }  // namespace g4fire
 
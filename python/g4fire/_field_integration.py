@@ -0,0 +1,50 @@
+"""Configuration of the integration of tracks in magnetic fields"""
+
+
+class FieldIntegration:
+    """Stepper and accuracy of the field integration of a field or region
+
+    Overrides the settings from the FieldIntegration blocks referenced in
+    the GDML. Exactly one of field or region should be given. Settings
+    that are left at their defaults are not changed.
+
+    Parameters
+    ----------
+    field : str, optional
+        Name of the magnetic field (as defined in the GDML) to configure
+    region : str, optional
+        Name of the region (as defined in the GDML) to configure
+    stepper : str, optional
+        Name of the Geant4 stepper class without the G4 prefix,
+        e.g. 'ClassicalRK4', 'SimpleRunge' or 'DormandPrince745'
+    delta_chord : float, optional
+        Maximum miss distance of a chord [mm]
+    delta_one_step : float, optional
+        Accuracy of the end point of a step [mm]
+    delta_intersection : float, optional
+        Accuracy of the intersection with a boundary [mm]
+    epsilon_min : float, optional
+        Minimum relative accuracy of a step
+    epsilon_max : float, optional
+        Maximum relative accuracy of a step
+    min_step : float, optional
+        Minimum step of the chord finder [mm]
+    """
+
+    def __init__(self, field='', region='', stepper='', delta_chord=-1.,
+                 delta_one_step=-1., delta_intersection=-1.,
+                 epsilon_min=-1., epsilon_max=-1., min_step=-1.):
+        self.field = field
+        self.region = region
+        self.stepper = stepper
+        self.delta_chord = delta_chord
+        self.delta_one_step = delta_one_step
+        self.delta_intersection = delta_intersection
+        self.epsilon_min = epsilon_min
+        self.epsilon_max = epsilon_max
+        self.min_step = min_step
+
+    def __repr__(self):
+        return 'FieldIntegration(%s, %s)' % (
+            self.field if self.field else self.region,
+            self.stepper if self.stepper else 'default stepper')
@@ -0,0 +1,40 @@
+"""Configuration of the killing of particles looping in a magnetic field"""
+
+
+class LooperPolicy:
+    """Looper thresholds of a single region
+
+    A track is looping if the field propagator could not finish its
+    step. Looping tracks below the warning energy are killed immediately,
+    looping tracks below the important energy are killed after the
+    maximum number of consecutive looping steps and tracks at or above the
+    important energy are never killed. Geant4's own looper thresholds
+    are relaxed so that they do not kill tracks before the policy does,
+    the tracks Geant4 still kills are counted as killed loopers as well.
+
+    Parameters
+    ----------
+    region : str, optional
+        Name of the region these thresholds apply to, all regions without
+        their own thresholds if empty
+    warning_energy : float, optional
+        Looping tracks below this kinetic energy are killed immediately [MeV]
+    important_energy : float, optional
+        Looping tracks at or above this kinetic energy are never killed [MeV]
+    max_looping_steps : int, optional
+        Number of consecutive looping steps before a track is killed,
+        0 to never kill tracks above the warning energy
+    """
+
+    def __init__(self, region='', warning_energy=0.,
+                 important_energy=1e300, max_looping_steps=0):
+        self.region = region
+        self.warning_energy = warning_energy
+        self.important_energy = important_energy
+        self.max_looping_steps = max_looping_steps
+
+    def __repr__(self):
+        return 'LooperPolicy(%s, [%s, %s] MeV, %s steps)' % (
+            self.region if self.region else 'all regions',
+            self.warning_energy, self.important_energy,
+            self.max_looping_steps)
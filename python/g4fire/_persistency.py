@@ -0,0 +1,50 @@
+"""Configuration of how the simulated hit collections are persisted"""
+
+
+class HitQuantization:
+    """Reduced-precision storage of the kinematics of one hit collection
+
+    The kinematic fields of each hit in the collection are encoded into
+    narrower codes right before they are written out, so the output size
+    shrinks while the physics content stays within the detector
+    resolution. A quantized collection is always written in a columnar
+    layout (Fixed/Half SimTrackerHitColumns or SimCalorimeterHitColumns)
+    and its mode and step sizes are recorded in the run header.
+
+    Parameters
+    ----------
+    collection : str
+        Name of the hits collection to quantize
+    mode : str, optional
+        'fixed' stores every field as a 32-bit count of multiples of its
+        step size (precision loss of at most half a step), 'float16'
+        stores every field as a 16-bit half-precision float (relative
+        precision loss of at most 2^-11, values beyond 65504 saturate,
+        step sizes are ignored)
+    position : float, optional
+        Step size of the positions [mm], 0 keeps the full float
+    momentum : float, optional
+        Step size of the momenta [MeV], 0 keeps the full float
+    energy : float, optional
+        Step size of the total energies [MeV], 0 keeps the full float
+    edep : float, optional
+        Step size of the energy depositions [MeV], 0 keeps the full float
+    time : float, optional
+        Step size of the times [ns], 0 keeps the full float
+    path_length : float, optional
+        Step size of the path lengths [mm], 0 keeps the full float
+    """
+
+    def __init__(self, collection, mode='fixed', position=0., momentum=0.,
+                 energy=0., edep=0., time=0., path_length=0.):
+        self.collection = collection
+        self.mode = mode
+        self.position = position
+        self.momentum = momentum
+        self.energy = energy
+        self.edep = edep
+        self.time = time
+        self.path_length = path_length
+
+    def __repr__(self):
+        return 'HitQuantization(%s, %s)' % (self.collection, self.mode)
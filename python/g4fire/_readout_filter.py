@@ -0,0 +1,33 @@
+"""Configuration of the readout emulation of the sensitive detectors"""
+
+
+class ReadoutFilter:
+    """Readout window and zero-suppression of a single sensitive detector
+
+    Steps outside of the readout window never create a hit and the hits
+    of cells whose total energy deposition in the event is below the
+    threshold are removed at the end of the event.
+
+    Parameters
+    ----------
+    sensitive_detector : str
+        Name of the sensitive detector to configure
+    min_time : float, optional
+        Start of the readout window in global time [ns]
+    max_time : float, optional
+        End of the readout window in global time [ns]
+    threshold : float, optional
+        Minimum total energy deposited in a cell to keep its hits [MeV]
+    """
+
+    def __init__(self, sensitive_detector, min_time=-1e300, max_time=1e300,
+                 threshold=0.):
+        self.sensitive_detector = sensitive_detector
+        self.min_time = min_time
+        self.max_time = max_time
+        self.threshold = threshold
+
+    def __repr__(self):
+        return 'ReadoutFilter(%s, [%s, %s] ns, %s MeV)' % (
+            self.sensitive_detector, self.min_time, self.max_time,
+            self.threshold)
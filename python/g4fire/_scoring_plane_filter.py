@@ -0,0 +1,29 @@
+"""Configuration of the crossings recorded by the scoring planes"""
+
+
+class ScoringPlaneFilter:
+    """Particle selection and deduplication of a single scoring plane
+
+    Parameters
+    ----------
+    sensitive_detector : str
+        Name of the scoring plane sensitive detector to configure
+    first_crossing_only : bool, optional
+        Record exactly one hit per track per plane at the point where the
+        track entered the plane instead of one hit per step in the plane
+    pdg_ids : list of int, optional
+        Only record particles with these PDG IDs, all particles are
+        recorded if this is empty
+    min_momentum : float, optional
+        Only record particles with at least this momentum [MeV]
+    """
+
+    def __init__(self, sensitive_detector, first_crossing_only=True,
+                 pdg_ids=[], min_momentum=0.):
+        self.sensitive_detector = sensitive_detector
+        self.first_crossing_only = first_crossing_only
+        self.pdg_ids = pdg_ids
+        self.min_momentum = min_momentum
+
+    def __repr__(self):
+        return 'ScoringPlaneFilter(%s)' % self.sensitive_detector
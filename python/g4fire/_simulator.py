@@ -36,14 +36,45 @@ class Simulator(Processor):
         Describe this run in a human-readable way
     scoringPlanes : str, optional
         Full path to the scoring planes gdml (suggested to use setDetector)
+    scoring_planes_mode : str, optional
+        'parallel_world' loads the scoring planes into a parallel world,
+        'analytic' finds the crossings of the planes from the step points
+        without any additional navigation (planes must be unrotated boxes)
     beamSpotSmear : list of float, optional
         2 (x,y) or 3 (x,y,z) widths to smear ALL primary vertices by [mm]
     time_shift_primaries : bool
         Should we shift the times of primaries so that z=0mm corresponds to t=0ns? 
     enableHitContribs : bool, optional
         Should the simulation save contributions to Ecal sim hits?
+        With biasing operators that split tracks, the contributions hold the
+        track weights the Ecal energy depositions must be weighted by.
     compressHitContribs : bool, optional
         Should the simulation compress contributions to Ecal sim hits by PDG ID?
+        Only steps of the same track weight are compressed together.
+    columnar_output : bool, optional
+        Write the sim hit collections in a columnar layout (one flat array
+        per field per event) instead of one object per hit
+    quantization : list of HitQuantization, optional
+        Reduced-precision storage of the kinematics of selected hit collections
+    drop_collections : list of str, optional
+        Regular expressions of hit collection names to never persist,
+        the sensitive detectors of these collections are deactivated
+    keep_collections_if_filtered : list of str, optional
+        Regular expressions of hit collection names to only persist
+        for events that a filter action marked as passing (by calling
+        UserAction::passEvent)
+    readout_filters : list of ReadoutFilter, optional
+        Readout time windows and zero-suppression thresholds of
+        individual sensitive detectors
+    scoring_plane_filters : list of ScoringPlaneFilter, optional
+        Particle selection and deduplication of the crossings recorded
+        by individual scoring planes
+    field_integration : list of FieldIntegration, optional
+        Stepper and accuracy of the field integration in individual
+        fields or regions, overriding the settings in the GDML
+    looper_policy : list of LooperPolicy, optional
+        Thresholds for killing particles looping in a magnetic field,
+        per region
     preInitCommands : list of str, optional
         Geant4 commands to run before the run is initialized
     postInitCommands : list of str, optional
@@ -63,10 +94,19 @@ class Simulator(Processor):
     """
     def __init__(self, instance_name, detector, description, generators, 
                  scoring_planes='',
+                 scoring_planes_mode='parallel_world',
                  beam_spot_delta=[],
                  time_shift_primaries=True,
                  enable_hit_contribs=True,
                  compress_hit_contribs=True,
+                 columnar_output=False,
+                 quantization=[],
+                 drop_collections=[],
+                 keep_collections_if_filtered=[],
+                 readout_filters=[],
+                 scoring_plane_filters=[],
+                 field_integration=[],
+                 looper_policy=[],
                  pre_init_cmds=[],
                  post_init_cmds=[],
                  actions=[],
@@ -81,10 +121,19 @@ class Simulator(Processor):
                          generators=generators,
                          module="g4fire",
                          scoring_planes=scoring_planes,
+                         scoring_planes_mode=scoring_planes_mode,
                          beam_spot_delta=beam_spot_delta,
                          time_shift_primaries=time_shift_primaries,
                          enable_hit_contribs=enable_hit_contribs,
                          compress_hit_contribs=compress_hit_contribs,
+                         columnar_output=columnar_output,
+                         quantization=quantization,
+                         drop_collections=drop_collections,
+                         keep_collections_if_filtered=keep_collections_if_filtered,
+                         readout_filters=readout_filters,
+                         scoring_plane_filters=scoring_plane_filters,
+                         field_integration=field_integration,
+                         looper_policy=looper_policy,
                          pre_init_cmds=pre_init_cmds,
                          post_init_cmds=post_init_cmds,
                          actions=actions,
@@ -0,0 +1,116 @@
+#include "g4fire/AnalyticScoringPlanes.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "G4Box.hh"
+#include "G4SDManager.hh"
+
+#include "fire/exception/Exception.h"
+
+#include "g4fire/CrossingFilter.h"
+
+namespace g4fire {
+
+AnalyticScoringPlanes::AnalyticScoringPlanes(G4GDMLParser *parser) {
+  auto world{parser->GetWorldVolume()->GetLogicalVolume()};
+  for (int index{0}; index < world->GetNoDaughters(); ++index) {
+    auto physical{world->GetDaughter(index)};
+    auto logical{physical->GetLogicalVolume()};
+
+    auto box{dynamic_cast<G4Box *>(logical->GetSolid())};
+    if (!box or (physical->GetRotation() and
+                 !physical->GetRotation()->isIdentity())) {
+      throw fire::Exception("ScoringPlane",
+                            "Scoring plane '" + physical->GetName() +
+                                "' is not an unrotated box and can't be "
+                                "handled analytically.",
+                            false);
+    }
+
+    // find the sensitive detector that records the crossings of this plane
+    CrossingFilter *recorder{nullptr};
+    for (const auto &aux : parser->GetVolumeAuxiliaryInformation(logical)) {
+      if (aux.type == "SensDet") {
+        recorder = dynamic_cast<CrossingFilter *>(
+            G4SDManager::GetSDMpointer()->FindSensitiveDetector(aux.value));
+      }
+    }
+    if (!recorder) {
+      std::cout << "[ AnalyticScoringPlanes ]: Volume '" << physical->GetName()
+                << "' does not have a scoring plane sensitive detector, "
+                << "skipping it." << std::endl;
+      continue;
+    }
+
+    // the thinnest dimension of the box is the axis the plane is
+    // perpendicular to
+    std::array<double, 3> half{box->GetXHalfLength(), box->GetYHalfLength(),
+                               box->GetZHalfLength()};
+    int axis = std::min_element(half.begin(), half.end()) - half.begin();
+    auto translation{physical->GetTranslation()};
+
+    Plane plane;
+    plane.position = translation[axis];
+    for (int i{0}; i < 2; ++i) {
+      int other{(axis + 1 + i) % 3};
+      plane.center[i] = translation[other];
+      plane.half_width[i] = half[other];
+    }
+    plane.copy_number = physical->GetCopyNo();
+    plane.recorder = recorder;
+    planes_[axis].push_back(plane);
+
+    std::cout << "[ AnalyticScoringPlanes ]: Adding " << physical->GetName()
+              << " perpendicular to axis " << axis << " at " << plane.position
+              << " mm." << std::endl;
+  }
+
+  for (auto &planes : planes_) {
+    std::sort(planes.begin(), planes.end(),
+              [](const Plane &lhs, const Plane &rhs) {
+                return lhs.position < rhs.position;
+              });
+  }
+}
+
+void AnalyticScoringPlanes::stepping(const G4Step *step) {
+  const G4ThreeVector &pre{step->GetPreStepPoint()->GetPosition()};
+  const G4ThreeVector &post{step->GetPostStepPoint()->GetPosition()};
+
+  for (int axis{0}; axis < 3; ++axis) {
+    const auto &planes{planes_[axis]};
+    if (planes.empty() or pre[axis] == post[axis]) continue;
+
+    // only look at the planes between the two step points, a plane is
+    // crossed if the step starts on one side and ends on or beyond it
+    double low{std::min(pre[axis], post[axis])};
+    double high{std::max(pre[axis], post[axis])};
+    bool forward{post[axis] > pre[axis]};
+    auto comp = [](const Plane &plane, double pos) {
+      return plane.position < pos;
+    };
+    auto first{std::lower_bound(planes.begin(), planes.end(), low, comp)};
+    for (auto plane{first}; plane != planes.end() and plane->position <= high;
+         ++plane) {
+      if (forward ? plane->position == low : plane->position == high)
+        continue;
+
+      double fraction{(plane->position - pre[axis]) / (post[axis] - pre[axis])};
+      G4ThreeVector crossing{pre + fraction * (post - pre)};
+
+      bool inside{true};
+      for (int i{0}; i < 2; ++i) {
+        int other{(axis + 1 + i) % 3};
+        inside = inside and std::abs(crossing[other] - plane->center[i]) <=
+                                plane->half_width[i];
+      }
+      if (!inside) continue;
+
+      plane->recorder->recordCrossing(step, crossing, fraction,
+                                      plane->copy_number);
+    }
+  }
+}
+
+}  // namespace g4fire
@@ -12,33 +12,32 @@ namespace biasoperators {
 DarkBrem::DarkBrem(std::string name, const framework::config::Parameters& p)
     : XsecBiasingOperator(name, p) {
   volume_ = p.getParameter<std::string>("volume");
-  factor_ = p.getParameter<double>("factor");
   bias_all_ = p.getParameter<bool>("bias_all");
 }
 
 G4VBiasingOperation* DarkBrem::ProposeOccurenceBiasingOperation(
     const G4Track* track, const G4BiasingProcessInterface* callingProcess) {
-  std::string currentProcess =
-      callingProcess->GetWrappedProcess()->GetProcessName();
-  if (currentProcess.compare(this->getProcessToBias()) == 0) {
-    // bias only the primary particle if we don't want to bias all particles
-    if (not bias_all_ and track->GetParentID() != 0) return 0;
-
-    G4double interactionLength =
-        callingProcess->GetWrappedProcess()->GetCurrentInteractionLength();
-
-    double dbXsecUnbiased = 1. / interactionLength;
-    double dbXsecBiased = dbXsecUnbiased * factor_;
-
-    if (G4RunManager::GetRunManager()->GetVerboseLevel() > 1) {
-      std::cout << "[ DarkBremXsecBiasingOperator ]: "
-                << " Unbiased DBrem xsec: " << dbXsecUnbiased
-                << " -> Biased xsec: " << dbXsecBiased << std::endl;
-    }
-
-    return BiasedXsec(dbXsecBiased);
-  } else
-    return 0;
+  // leave immediately if the calling process isn't the one we bias
+  if (not isCalledBy(callingProcess, biased_process_)) return 0;
+
+  tuneFactor();
+
+  // bias only the primary particle if we don't want to bias all particles
+  if (not bias_all_ and track->GetParentID() != 0) return 0;
+
+  G4double interactionLength =
+      callingProcess->GetWrappedProcess()->GetCurrentInteractionLength();
+
+  double dbXsecUnbiased = 1. / interactionLength;
+  double dbXsecBiased = dbXsecUnbiased * factor_;
+
+  if (G4RunManager::GetRunManager()->GetVerboseLevel() > 1) {
+    std::cout << "[ DarkBremXsecBiasingOperator ]: "
+              << " Unbiased DBrem xsec: " << dbXsecUnbiased
+              << " -> Biased xsec: " << dbXsecBiased << std::endl;
+  }
+
+  return BiasedXsec(dbXsecBiased);
 }
 
 void DarkBrem::RecordConfig(ldmx::RunHeader& h) const {
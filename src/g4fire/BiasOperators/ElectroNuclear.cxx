@@ -8,7 +8,6 @@ ElectroNuclear::ElectroNuclear(std::string name,
                                const framework::config::Parameters& p)
     : XsecBiasingOperator(name, p) {
   volume_ = p.getParameter<std::string>("volume");
-  factor_ = p.getParameter<double>("factor");
   threshold_ = p.getParameter<double>("threshold");
 }
 
@@ -22,6 +21,11 @@ G4VBiasingOperation* ElectroNuclear::ProposeOccurenceBiasingOperation(
             << "Currently in volume " << track->GetVolume()->GetName()
             << std::endl;*/
 
+  // leave immediately if the calling process isn't the one we bias
+  if (not isCalledBy(callingProcess, biased_process_)) return 0;
+
+  tuneFactor();
+
   if (track->GetKineticEnergy() < threshold_) return 0;
 
   /*std::cout << "[ ElectroNuclearXsecBiasingOperator ]: "
@@ -29,26 +33,21 @@ G4VBiasingOperation* ElectroNuclear::ProposeOccurenceBiasingOperation(
             << callingProcess->GetWrappedProcess()->GetProcessName()
             << std::endl;*/
 
-  std::string currentProcess =
-      callingProcess->GetWrappedProcess()->GetProcessName();
-  if (currentProcess.compare(this->getProcessToBias()) == 0) {
-    G4double interactionLength =
-        callingProcess->GetWrappedProcess()->GetCurrentInteractionLength();
-    /*std::cout << "[ ElectroNuclearXsecBiasingOperator ]: "
-              << "EN Interaction length: "
-              << interactionLength << std::endl;*/
-
-    double enXsecUnbiased = 1. / interactionLength;
-    /*std::cout << "[ ElectroNuclearXsecBiasingOperator ]: Unbiased EN xsec: "
-              << enXsecUnbiased << std::endl;*/
-
-    double enXsecBiased = enXsecUnbiased * factor_;
-    /*std::cout << "[ ElectroNuclearXsecBiasingOperator ]: Biased EN xsec: "
-              << enXsecBiased << std::endl;*/
-
-    return BiasedXsec(enXsecBiased);
-  } else
-    return 0;
+  G4double interactionLength =
+      callingProcess->GetWrappedProcess()->GetCurrentInteractionLength();
+  /*std::cout << "[ ElectroNuclearXsecBiasingOperator ]: "
+            << "EN Interaction length: "
+            << interactionLength << std::endl;*/
+
+  double enXsecUnbiased = 1. / interactionLength;
+  /*std::cout << "[ ElectroNuclearXsecBiasingOperator ]: Unbiased EN xsec: "
+            << enXsecUnbiased << std::endl;*/
+
+  double enXsecBiased = enXsecUnbiased * factor_;
+  /*std::cout << "[ ElectroNuclearXsecBiasingOperator ]: Biased EN xsec: "
+            << enXsecBiased << std::endl;*/
+
+  return BiasedXsec(enXsecBiased);
 }
 
 }  // namespace biasoperators
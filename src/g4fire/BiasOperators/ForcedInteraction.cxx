@@ -0,0 +1,58 @@
+#include "g4fire/BiasOperators/ForcedInteraction.h"
+
+#include "G4GeometryTolerance.hh"
+#include "G4LogicalVolume.hh"
+#include "G4NavigationHistory.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VSolid.hh"
+#include "G4VTouchable.hh"
+
+namespace g4fire {
+namespace biasoperators {
+
+ForcedInteraction::ForcedInteraction(std::string name,
+                                     const fire::config::Parameters& p)
+    : XsecBiasingOperator(name, p, false) {
+  volume_ = p.get<std::string>("volume");
+  process_ = p.get<std::string>("process");
+  particle_ = p.get<std::string>("particle");
+  threshold_ = p.get<double>("threshold");
+}
+
+void ForcedInteraction::StartRun() {
+  XsecBiasingOperator::StartRun();
+
+  force_operation_ = new ForcedInteractionOperation("force-" + process_);
+}
+
+G4VBiasingOperation* ForcedInteraction::ProposeOccurenceBiasingOperation(
+    const G4Track* track, const G4BiasingProcessInterface* callingProcess) {
+  // leave immediately if the calling process isn't the one we bias
+  if (not isCalledBy(callingProcess, biased_process_)) return 0;
+
+  if (track->GetKineticEnergy() < threshold_) return 0;
+
+  G4double interactionLength =
+      callingProcess->GetWrappedProcess()->GetCurrentInteractionLength();
+  // a process that can't happen can't be forced
+  if (interactionLength >= DBL_MAX) return 0;
+
+  // distance to the boundary of the current volume along the track,
+  // computed in the local frame of the volume
+  const G4AffineTransform& transform{
+      track->GetTouchable()->GetHistory()->GetTopTransform()};
+  G4double distance =
+      track->GetVolume()->GetLogicalVolume()->GetSolid()->DistanceToOut(
+          transform.TransformPoint(track->GetPosition()),
+          transform.TransformAxis(track->GetMomentumDirection()));
+  if (distance <= G4GeometryTolerance::GetInstance()->GetSurfaceTolerance())
+    return 0;
+
+  force_operation_->Force(1. / interactionLength, distance);
+  return force_operation_;
+}
+
+}  // namespace biasoperators
+}  // namespace g4fire
+
+DECLARE_XSECBIASINGOPERATOR(g4fire::biasoperators, ForcedInteraction)
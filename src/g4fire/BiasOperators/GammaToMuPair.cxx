@@ -8,27 +8,26 @@ GammaToMuPair::GammaToMuPair(std::string name,
                              const framework::config::Parameters& p)
     : XsecBiasingOperator(name, p) {
   volume_ = p.getParameter<std::string>("volume");
-  factor_ = p.getParameter<double>("factor");
   threshold_ = p.getParameter<double>("threshold");
 }
 
 G4VBiasingOperation* GammaToMuPair::ProposeOccurenceBiasingOperation(
     const G4Track* track, const G4BiasingProcessInterface* callingProcess) {
+  // leave immediately if the calling process isn't the one we bias
+  if (not isCalledBy(callingProcess, biased_process_)) return 0;
+
+  tuneFactor();
+
   if (track->GetKineticEnergy() < threshold_) return 0;
 
-  std::string currentProcess =
-      callingProcess->GetWrappedProcess()->GetProcessName();
-  if (currentProcess.compare(this->getProcessToBias()) == 0) {
-    G4double interactionLength =
-        callingProcess->GetWrappedProcess()->GetCurrentInteractionLength();
+  G4double interactionLength =
+      callingProcess->GetWrappedProcess()->GetCurrentInteractionLength();
 
-    double enXsecUnbiased = 1. / interactionLength;
+  double enXsecUnbiased = 1. / interactionLength;
 
-    double enXsecBiased = enXsecUnbiased * factor_;
+  double enXsecBiased = enXsecUnbiased * factor_;
 
-    return BiasedXsec(enXsecBiased);
-  } else
-    return 0;
+  return BiasedXsec(enXsecBiased);
 }
 
 }  // namespace biasoperators
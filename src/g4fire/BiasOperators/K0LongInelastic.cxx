@@ -7,28 +7,27 @@ namespace biasoperators {
 K0LongInelastic::K0LongInelastic(std::string name, const framework::config::Parameters& p)
     : XsecBiasingOperator(name, p) {
   volume_ = p.getParameter<std::string>("volume");
-  factor_ = p.getParameter<double>("factor");
   threshold_ = p.getParameter<double>("threshold");
 }
 
 G4VBiasingOperation* K0LongInelastic::ProposeOccurenceBiasingOperation(
     const G4Track* track, const G4BiasingProcessInterface* callingProcess) {
 
+  // leave immediately if the calling process isn't the one we bias
+  if (not isCalledBy(callingProcess, biased_process_)) return 0;
+
+  tuneFactor();
+
   if (track->GetKineticEnergy() < threshold_) return 0;
 
-  std::string currentProcess =
-      callingProcess->GetWrappedProcess()->GetProcessName();
-  if (currentProcess.compare(this->getProcessToBias()) == 0) {
-    G4double interactionLength =
-        callingProcess->GetWrappedProcess()->GetCurrentInteractionLength();
+  G4double interactionLength =
+      callingProcess->GetWrappedProcess()->GetCurrentInteractionLength();
 
-    double k0LongInXsecUnbiased = 1. / interactionLength;
+  double k0LongInXsecUnbiased = 1. / interactionLength;
 
-    double k0LongInXsecBiased = k0LongInXsecUnbiased * factor_;
+  double k0LongInXsecBiased = k0LongInXsecUnbiased * factor_;
 
-    return BiasedXsec(k0LongInXsecBiased);
-  } else
-    return 0;
+  return BiasedXsec(k0LongInXsecBiased);
 }
 
 }  // namespace biasoperators
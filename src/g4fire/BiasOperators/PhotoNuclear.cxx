@@ -10,7 +10,6 @@ PhotoNuclear::PhotoNuclear(std::string name,
     : XsecBiasingOperator(name, p) {
   volume_ = p.getParameter<std::string>("volume");
   threshold_ = p.getParameter<double>("threshold");
-  factor_ = p.getParameter<double>("factor");
   down_bias_conv_ = p.getParameter<bool>("down_bias_conv");
   only_children_of_primary_ = p.getParameter<bool>("only_children_of_primary");
 }
@@ -18,7 +17,8 @@ PhotoNuclear::PhotoNuclear(std::string name,
 void PhotoNuclear::StartRun() {
   XsecBiasingOperator::StartRun();
 
-  if (processIsBiased(CONVERSION_PROCESS)) {
+  conversion_process_ = findBiasedProcess(CONVERSION_PROCESS);
+  if (conversion_process_) {
     emXsecOperation = new G4BOptnChangeCrossSection("changeXsec-conv");
   } else if (down_bias_conv_) {
     EXCEPTION_RAISE(
@@ -33,6 +33,15 @@ G4VBiasingOperation* PhotoNuclear::ProposeOccurenceBiasingOperation(
             << "Kinetic energy: " << track->GetKineticEnergy()
             << " MeV" << std::endl;*/
 
+  // leave immediately if the calling process is neither the one we bias nor
+  // the conversion we down-bias
+  bool is_pn{isCalledBy(callingProcess, biased_process_)};
+  if (not is_pn and
+      not(down_bias_conv_ and isCalledBy(callingProcess, conversion_process_)))
+    return 0;
+
+  tuneFactor();
+
   // if we want to only bias children of primary, leave if this track is NOT a
   // child of the primary
   if (only_children_of_primary_ and track->GetParentID() != 1) return 0;
@@ -45,9 +54,7 @@ G4VBiasingOperation* PhotoNuclear::ProposeOccurenceBiasingOperation(
             << callingProcess->GetWrappedProcess()->GetProcessName()
             << std::endl;*/
 
-  std::string currentProcess =
-      callingProcess->GetWrappedProcess()->GetProcessName();
-  if (currentProcess.compare(this->getProcessToBias()) == 0) {
+  if (is_pn) {
     G4double interactionLength =
         callingProcess->GetWrappedProcess()->GetCurrentInteractionLength();
     /*std::cout << "[ PhotoNuclearXsecBiasingOperator ]: "
@@ -64,8 +71,8 @@ G4VBiasingOperation* PhotoNuclear::ProposeOccurenceBiasingOperation(
 
     return BiasedXsec(pnXsecBiased_);
 
-  } else if ((currentProcess.compare(CONVERSION_PROCESS) == 0) and
-             down_bias_conv_) {
+  } else {
+    // the conversion process, which we down-bias
     G4double interactionLength =
         callingProcess->GetWrappedProcess()->GetCurrentInteractionLength();
     /*std::cout << "[ PhotoNuclearXsecBiasingOperator ]: "
@@ -81,6 +88,8 @@ G4VBiasingOperation* PhotoNuclear::ProposeOccurenceBiasingOperation(
     if (emXsecBiased == pnXsecUnbiased_) {
       G4cout << "[ PhotoNuclearXsecBiasingOperator ]: [ WARNING ]: "
              << "Biasing factor is too large." << std::endl;
+      // don't choose this factor if we are tuning it
+      rejectFactor();
     }
     /*std::cout << "[ PhotoNuclearXsecBiasingOperator ]: Biased EM xsec: "
               << emXsecBiased << std::endl;*/
@@ -89,9 +98,7 @@ G4VBiasingOperation* PhotoNuclear::ProposeOccurenceBiasingOperation(
     emXsecOperation->Sample();
 
     return emXsecOperation;
-
-  } else
-    return 0;
+  }
 }
 
 }  // namespace biasoperators
@@ -0,0 +1,118 @@
+#include "g4fire/BiasOperators/SecondarySplitting.h"
+
+#include <algorithm>
+
+#include "G4VParticleChange.hh"
+
+#include "fire/exception/Exception.h"
+
+namespace g4fire {
+namespace biasoperators {
+
+G4VParticleChange* SplitFinalStateOperation::ApplyFinalStateBiasing(
+    const G4BiasingProcessInterface* callingProcess, const G4Track* track,
+    const G4Step* step, G4bool&) {
+  G4VParticleChange* change =
+      callingProcess->GetWrappedProcess()->PostStepDoIt(*track, *step);
+
+  G4int num_secondaries{change->GetNumberOfSecondaries()};
+  bool any_selected{false};
+  for (G4int i = 0; i < num_secondaries and not any_selected; ++i)
+    any_selected = isSelected(change->GetSecondary(i));
+  // nothing to split, leave the particle change as it is
+  if (not any_selected) return change;
+
+  // copy out the secondaries first, re-sizing the list of the particle
+  // change deletes the ones it holds
+  std::vector<G4Track*> secondaries;
+  for (G4int i = 0; i < num_secondaries; ++i) {
+    const G4Track* secondary{change->GetSecondary(i)};
+    int copies{isSelected(secondary) ? split_factor_ : 1};
+    for (int i_copy = 0; i_copy < copies; ++i_copy) {
+      G4Track* copy = new G4Track(*secondary);
+      copy->SetWeight(secondary->GetWeight() / copies);
+      secondaries.push_back(copy);
+    }
+  }
+
+  change->SetNumberOfSecondaries(secondaries.size());
+  G4bool weight_by_process{change->IsSecondaryWeightSetByProcess()};
+  change->SetSecondaryWeightByProcess(true);
+  for (G4Track* copy : secondaries) change->AddSecondary(copy);
+  // the particle change is re-used by the process when it isn't biased
+  change->SetSecondaryWeightByProcess(weight_by_process);
+
+  return change;
+}
+
+bool SplitFinalStateOperation::isSelected(const G4Track* secondary) const {
+  if (secondary->GetKineticEnergy() < min_kinetic_energy_) return false;
+  if (pdg_ids_.empty()) return true;
+  return std::find(pdg_ids_.begin(), pdg_ids_.end(),
+                   secondary->GetDefinition()->GetPDGEncoding()) !=
+         pdg_ids_.end();
+}
+
+SecondarySplitting::SecondarySplitting(std::string name,
+                                       const fire::config::Parameters& p)
+    : XsecBiasingOperator(name, p, false) {
+  volume_ = p.get<std::string>("volume");
+  process_ = p.get<std::string>("process");
+  particle_ = p.get<std::string>("particle");
+  threshold_ = p.get<double>("threshold");
+  split_factor_ = p.get<int>("split_factor");
+  pdg_ids_ = p.get<std::vector<int>>("pdg_ids", {});
+  min_kinetic_energy_ = p.get<double>("min_kinetic_energy", 0.);
+
+  if (split_factor_ < 1) {
+    throw fire::Exception("BiasSetup",
+                          "The split factor must be at least one, not " +
+                              std::to_string(split_factor_) + ".",
+                          false);
+  }
+}
+
+void SecondarySplitting::StartRun() {
+  XsecBiasingOperator::StartRun();
+
+  split_operation_ = new SplitFinalStateOperation(
+      "split-" + process_, split_factor_, pdg_ids_, min_kinetic_energy_);
+}
+
+G4VBiasingOperation* SecondarySplitting::ProposeOccurenceBiasingOperation(
+    const G4Track* track, const G4BiasingProcessInterface* callingProcess) {
+  // leave immediately if the calling process isn't the one we bias
+  if (not isCalledBy(callingProcess, biased_process_)) return 0;
+
+  tuneFactor();
+
+  if (track->GetKineticEnergy() < threshold_) return 0;
+
+  // only split the products, the occurence is unchanged; while tuning,
+  // an unbiased cross section is still proposed so that a factor of one
+  // gets its occurences scored like the others
+  if (factor_ == 1. and not isTuningFactor()) return 0;
+
+  G4double interactionLength =
+      callingProcess->GetWrappedProcess()->GetCurrentInteractionLength();
+
+  double xsecUnbiased = 1. / interactionLength;
+
+  double xsecBiased = xsecUnbiased * factor_;
+
+  return BiasedXsec(xsecBiased);
+}
+
+G4VBiasingOperation* SecondarySplitting::ProposeFinalStateBiasingOperation(
+    const G4Track* track, const G4BiasingProcessInterface* callingProcess) {
+  if (not isCalledBy(callingProcess, biased_process_)) return 0;
+
+  if (track->GetKineticEnergy() < threshold_) return 0;
+
+  return split_operation_;
+}
+
+}  // namespace biasoperators
+}  // namespace g4fire
+
+DECLARE_XSECBIASINGOPERATOR(g4fire::biasoperators, SecondarySplitting)
@@ -0,0 +1,138 @@
+#include "g4fire/BiasOperators/WeightWindow.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "G4EventManager.hh"
+#include "Randomize.hh"
+
+#include "fire/exception/Exception.h"
+
+#include "g4fire/UserEventInformation.h"
+#include "g4fire/UserTrackInformation.h"
+
+namespace g4fire {
+namespace biasoperators {
+
+G4VParticleChange* WeightWindowOperation::GenerateBiasingFinalState(
+    const G4Track* track, const G4Step*) {
+  particle_change_.Initialize(*track);
+  if (not window_ or track->GetTrackStatus() != fAlive)
+    return &particle_change_;
+
+  double weight{track->GetWeight()};
+  double new_weight{weight};
+  if (weight > window_->upper_weight) {
+    int copies = std::min<int>(
+        std::ceil(weight / window_->upper_weight), max_split_);
+    new_weight = weight / copies;
+    particle_change_.ProposeParentWeight(new_weight);
+    particle_change_.SetSecondaryWeightByProcess(true);
+    particle_change_.SetNumberOfSecondaries(copies - 1);
+    for (int i_copy = 1; i_copy < copies; ++i_copy) {
+      G4Track* copy = new G4Track(*track);
+      copy->SetWeight(new_weight);
+      particle_change_.AddSecondary(copy);
+    }
+  } else if (weight < window_->lower_weight) {
+    if (G4UniformRand() * window_->survival_weight < weight) {
+      new_weight = window_->survival_weight;
+      particle_change_.ProposeParentWeight(new_weight);
+    } else {
+      particle_change_.ProposeTrackStatus(fStopAndKill);
+    }
+  }
+
+  // The stepping action folds the change in the weight of the track into
+  // the weight of the event, undo it since the expected weight is kept.
+  // The track keeps the change for its hits (and those of its copies).
+  if (new_weight != weight) {
+    static_cast<UserEventInformation*>(
+        G4EventManager::GetEventManager()->GetUserInformation())
+        ->incWeight(weight / new_weight);
+    UserTrackInformation::get(track)->foldWeight(weight / new_weight);
+  }
+
+  return &particle_change_;
+}
+
+WeightWindow::WeightWindow(std::string name,
+                           const fire::config::Parameters& p)
+    : XsecBiasingOperator(name, p, false) {
+  volume_ = p.get<std::string>("volume");
+  particles_ = p.get<std::vector<std::string>>("particles");
+  max_split_ = p.get<int>("max_split", 10);
+
+  if (particles_.empty()) {
+    throw fire::Exception("BiasSetup",
+                          "No particles given to the weight window.", false);
+  }
+  if (max_split_ < 1) {
+    throw fire::Exception("BiasSetup",
+                          "The maximum split must be at least one.", false);
+  }
+
+  for (const auto& window :
+       p.get<std::vector<fire::config::Parameters>>("windows")) {
+    double lower{window.get<double>("lower_weight")};
+    double upper{window.get<double>("upper_weight")};
+    double survival{
+        window.get<double>("survival_weight", std::sqrt(lower * upper))};
+    if (lower <= 0. or lower > survival or survival > upper) {
+      throw fire::Exception("BiasSetup",
+                            "The weight window bounds must satisfy 0 < "
+                            "lower_weight <= survival_weight <= upper_weight.",
+                            false);
+    }
+    windows_.push_back(
+        {window.get<double>("max_energy"), lower, upper, survival});
+  }
+  std::sort(windows_.begin(), windows_.end(),
+            [](const Window& l, const Window& r) {
+              return l.max_energy < r.max_energy;
+            });
+}
+
+void WeightWindow::StartRun() {
+  XsecBiasingOperator::StartRun();
+
+  window_operation_ = new WeightWindowOperation("weightWindow", max_split_);
+}
+
+G4VBiasingOperation* WeightWindow::ProposeNonPhysicsBiasingOperation(
+    const G4Track* track, const G4BiasingProcessInterface*) {
+  auto window{std::upper_bound(
+      windows_.begin(), windows_.end(), track->GetKineticEnergy(),
+      [](double energy, const Window& w) { return energy < w.max_energy; })};
+  if (window == windows_.end()) return 0;
+
+  // leave the track alone if it is within its window
+  double weight{track->GetWeight()};
+  if (weight >= window->lower_weight and weight <= window->upper_weight)
+    return 0;
+
+  window_operation_->SetWindow(&(*window));
+  return window_operation_;
+}
+
+void WeightWindow::RecordConfig(fire::RunHeader& h) const {
+  h.set<std::string>("BiasOperator::WeightWindow::Volume", volume_);
+  std::string particles;
+  for (const auto& particle : particles_)
+    particles += (particles.empty() ? "" : ",") + particle;
+  h.set<std::string>("BiasOperator::WeightWindow::Particles", particles);
+  h.set<int>("BiasOperator::WeightWindow::Max Split", max_split_);
+  for (std::size_t i = 0; i < windows_.size(); ++i) {
+    std::string prefix{"BiasOperator::WeightWindow::Window " +
+                       std::to_string(i) + "::"};
+    h.set<float>(prefix + "Max Energy", windows_[i].max_energy);
+    h.set<float>(prefix + "Lower Weight", windows_[i].lower_weight);
+    h.set<float>(prefix + "Upper Weight", windows_[i].upper_weight);
+    h.set<float>(prefix + "Survival Weight", windows_[i].survival_weight);
+  }
+}
+
+}  // namespace biasoperators
+}  // namespace g4fire
+
+DECLARE_XSECBIASINGOPERATOR(g4fire::biasoperators, WeightWindow)
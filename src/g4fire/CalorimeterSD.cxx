@@ -32,6 +32,9 @@ void CalorimeterSD::Initialize(G4HCofThisEvent* hce) {
 }
 
 void CalorimeterSD::EndOfEvent(G4HCofThisEvent*) {
+  // Remove the hits in cells below the zero-suppression threshold
+  suppress(hitsCollection_);
+
   // Print number of hits.
   if (this->verboseLevel > 0) {
     std::cout << GetName() << " had " << hitsCollection_->entries()
@@ -0,0 +1,311 @@
+#include "g4fire/DarkBrem/DarkBremAnalyticModel.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "fire/exception/Exception.h"
+
+#include "g4fire/DarkBrem/G4APrime.h"
+#include "g4fire/DarkBrem/GaussKronrod.h"
+#include "g4fire/DarkBrem/WeizsackerWilliams.h"
+
+#include "G4Electron.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+
+namespace g4fire {
+namespace darkbrem {
+
+namespace {
+
+/// identifies a cached x table
+const char MAGIC[8] = {'G', '4', 'F', 'D', 'B', 'C', 'D', 'F'};
+
+/// version of the cached x table written by this code
+const uint32_t VERSION = 1;
+
+/**
+ * Header at the start of a cached x table, the CDF values follow it.
+ */
+struct TableHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t num_bins;
+  /// mass of the A' [GeV]
+  double aprime_mass;
+  /// maximum incident energy [GeV]
+  double max_energy;
+};
+
+} // namespace
+
+DarkBremAnalyticModel::DarkBremAnalyticModel(fire::config::Parameters &params)
+    : G4eDarkBremsstrahlungModel(params) {
+  threshold_ = std::max(
+      params.get<double>("threshold"),
+      2. * G4APrime::APrime()->GetPDGMass() / CLHEP::GeV // mass A' in GeV
+  );
+
+  epsilon_ = params.get<double>("epsilon");
+  num_x_bins_ = params.get<int>("num_x_bins", 1000);
+  max_energy_ = params.get<double>("max_energy", 1000.);
+  table_file_ = params.get<std::string>("table_file", "");
+
+  if (num_x_bins_ < 1 or max_energy_ <= threshold_) {
+    throw fire::Exception("BadConfig",
+                          "The analytic dark brem model needs at least one "
+                          "bin and a maximum energy above the threshold.",
+                          false);
+  }
+
+  if (!LoadTable()) {
+    BuildTable();
+    if (!table_file_.empty()) SaveTable();
+  }
+}
+
+void DarkBremAnalyticModel::PrintInfo() const {
+  G4cout << " Dark Brem Analytic Model" << G4endl;
+  G4cout << "   Threshold [GeV]:  " << threshold_ << G4endl;
+  G4cout << "   Epsilon:          " << epsilon_ << G4endl;
+  G4cout << "   X Table Bins:     " << num_x_bins_ << G4endl;
+  G4cout << "   Max Energy [GeV]: " << max_energy_ << G4endl;
+}
+
+void DarkBremAnalyticModel::RecordConfig(fire::RunHeader &h) const {
+  h.set<float>("Minimum Threshold to DB [GeV]", threshold_);
+  h.set<float>("DB Xsec Epsilon", epsilon_);
+  h.set<int>("DB Analytic X Table Bins", num_x_bins_);
+  h.set<float>("DB Analytic Max Energy [GeV]", max_energy_);
+}
+
+std::string DarkBremAnalyticModel::CacheKey() const {
+  std::ostringstream key;
+  key << "analytic_threshold" << threshold_ << "_epsilon" << epsilon_;
+  return key.str();
+}
+
+G4double DarkBremAnalyticModel::GetThreshold() const {
+  return threshold_ * CLHEP::GeV;
+}
+
+G4double DarkBremAnalyticModel::ComputeCrossSectionPerAtom(
+    G4double electron_ke, G4double A, G4double Z) {
+  return ComputeCrossSectionPerAtomAtMass(electron_ke, A, Z,
+                                          G4APrime::APrime()->GetPDGMass());
+}
+
+G4double DarkBremAnalyticModel::ComputeCrossSectionPerAtomAtMass(
+    G4double electron_ke, G4double A, G4double Z, G4double ap_mass) {
+  double MA = ap_mass / CLHEP::GeV; // mass A' in GeV
+
+  if (electron_ke < keV)
+    return 0.; // outside viable region for model
+
+  electron_ke = electron_ke / CLHEP::GeV; // Change energy to GeV.
+
+  if (electron_ke < std::max(threshold_, 2. * MA))
+    return 0.; // can't produce a prime
+
+  return ww::CrossSectionPerAtom(electron_ke, A, Z, MA, epsilon_);
+}
+
+void DarkBremAnalyticModel::GenerateChange(G4ParticleChange &particle_change,
+                                           const G4Track &track,
+                                           const G4Step &step) {
+  static const double MA =
+      G4APrime::APrime()->GetPDGMass() / CLHEP::GeV; // mass A' in GeV
+  static const double Mel =
+      G4Electron::Electron()->GetPDGMass() / CLHEP::GeV; // mass electron in GeV
+
+  // energy of the incident electron in GeV
+  double E0 = step.GetPostStepPoint()->GetTotalEnergy() / CLHEP::GeV;
+
+  double x = SampleX(E0);
+
+  // y = E0^2 x theta^2 is only the small angle approximation, but the
+  // angle still can't go above pi
+  double c = MA * MA * (1. - x) / x + Mel * Mel * x;
+  double s_max = E0 * E0 * x * CLHEP::pi * CLHEP::pi / c;
+  double w = SampleW(x, s_max / (1. + s_max));
+  double theta = std::min(sqrt(w / (1. - w) * c / (E0 * E0 * x)), CLHEP::pi);
+  double phi = CLHEP::twopi * G4UniformRand();
+
+  G4double ap_energy = x * E0 * CLHEP::GeV;
+  G4ThreeVector dp_p(std::sin(theta) * std::cos(phi),
+                     std::sin(theta) * std::sin(phi), std::cos(theta));
+  dp_p.rotateUz(track.GetMomentumDirection());
+  dp_p.setMag(sqrt(std::max(0., ap_energy * ap_energy -
+                                    MA * MA * CLHEP::GeV * CLHEP::GeV)));
+  G4DynamicParticle *dphoton = new G4DynamicParticle(G4APrime::APrime(), dp_p);
+
+  // the electron keeps the rest of the energy, its direction balances the
+  // transverse momentum of the A'
+  // NOTE: does _not_ take nucleus recoil into account
+  G4ThreeVector recoil_e_p = track.GetMomentum() - dp_p;
+  G4double final_ke = std::max(
+      0., (1. - x) * E0 * CLHEP::GeV - electron_mass_c2);
+
+  // stop tracking and create new secondary instead of primary
+  if (always_create_new_electron_) {
+    G4DynamicParticle *el = new G4DynamicParticle(
+        track.GetDefinition(), recoil_e_p.unit(), final_ke);
+    particle_change.SetNumberOfSecondaries(2);
+    particle_change.AddSecondary(dphoton);
+    particle_change.AddSecondary(el);
+    particle_change.ProposeTrackStatus(fStopAndKill);
+    // continue tracking
+  } else {
+    // just have primary lose energy (don't rename to different track ID)
+    particle_change.SetNumberOfSecondaries(1);
+    particle_change.AddSecondary(dphoton);
+    particle_change.ProposeMomentumDirection(recoil_e_p.unit());
+    particle_change.ProposeEnergy(final_ke);
+  }
+}
+
+void DarkBremAnalyticModel::BuildTable() {
+  static const double MA =
+      G4APrime::APrime()->GetPDGMass() / CLHEP::GeV; // mass A' in GeV
+  static const double Mel =
+      G4Electron::Electron()->GetPDGMass() / CLHEP::GeV; // mass electron in GeV
+
+  // x can't go above 1 - max(m_e, m_A)/E0
+  z_max_ = -std::log(std::max(Mel, MA) / max_energy_);
+
+  // cross section in z = -ln(1-x), the y integral of A12 is analytic
+  auto density = [](double z) {
+    double x = -std::expm1(-z);
+    double c = MA * MA * (1. - x) / x + Mel * Mel * x;
+    double g = (1. - x + x * x / 2.) / c -
+               x * (1. - x) * MA * MA *
+                   (1. / (6. * c * c) + Mel * Mel * x / (3. * c * c * c));
+    return g * (1. - x);
+  };
+
+  double dz = z_max_ / num_x_bins_;
+  cdf_.assign(num_x_bins_ + 1, 0.);
+  for (int i = 0; i < num_x_bins_; i++) {
+    cdf_[i + 1] = cdf_[i] + gausskronrod::integrate(density, i * dz,
+                                                    (i + 1) * dz);
+  }
+  for (auto &value : cdf_) value /= cdf_.back();
+}
+
+bool DarkBremAnalyticModel::LoadTable() {
+  if (table_file_.empty()) return false;
+
+  std::ifstream file(table_file_, std::ios::binary);
+  TableHeader header;
+  if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) or
+      std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 or
+      header.version != VERSION or
+      header.num_bins != uint32_t(num_x_bins_) or
+      header.aprime_mass != G4APrime::APrime()->GetPDGMass() / CLHEP::GeV or
+      header.max_energy != max_energy_)
+    return false;
+
+  std::vector<double> cdf(num_x_bins_ + 1);
+  if (!file.read(reinterpret_cast<char *>(&z_max_), sizeof(z_max_)) or
+      !file.read(reinterpret_cast<char *>(cdf.data()),
+                 cdf.size() * sizeof(double)))
+    return false;
+
+  cdf_ = std::move(cdf);
+  return true;
+}
+
+void DarkBremAnalyticModel::SaveTable() const {
+  TableHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.num_bins = num_x_bins_;
+  header.aprime_mass = G4APrime::APrime()->GetPDGMass() / CLHEP::GeV;
+  header.max_energy = max_energy_;
+
+  std::ofstream file(table_file_, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char *>(&z_max_), sizeof(z_max_));
+  file.write(reinterpret_cast<const char *>(cdf_.data()),
+             cdf_.size() * sizeof(double));
+  if (!file.good()) {
+    throw fire::Exception("FileWrite",
+                          "Unable to write dark brem x table '" +
+                              table_file_ + "'.",
+                          false);
+  }
+}
+
+double DarkBremAnalyticModel::CDF(double z) const {
+  double position = std::clamp(z / z_max_, 0., 1.) * num_x_bins_;
+  int i = std::min(int(position), num_x_bins_ - 1);
+  return cdf_[i] + (position - i) * (cdf_[i + 1] - cdf_[i]);
+}
+
+double DarkBremAnalyticModel::SampleX(double E0) const {
+  static const double MA =
+      G4APrime::APrime()->GetPDGMass() / CLHEP::GeV; // mass A' in GeV
+  static const double Mel =
+      G4Electron::Electron()->GetPDGMass() / CLHEP::GeV; // mass electron in GeV
+
+  // the A' must be on shell and the electron must keep its mass
+  double z_min = -std::log1p(-MA / E0);
+  double z_max = -std::log(std::max(Mel, MA) / E0);
+  double u_min = CDF(z_min);
+  double u = u_min + G4UniformRand() * (CDF(z_max) - u_min);
+
+  // invert the linear interpolation of the CDF
+  int i = std::upper_bound(cdf_.begin(), cdf_.end(), u) - cdf_.begin() - 1;
+  i = std::clamp(i, 0, num_x_bins_ - 1);
+  double bin_fraction =
+      cdf_[i + 1] > cdf_[i] ? (u - cdf_[i]) / (cdf_[i + 1] - cdf_[i]) : 0.;
+  double z = std::clamp((i + bin_fraction) * z_max_ / num_x_bins_, z_min,
+                        z_max);
+  return -std::expm1(-z);
+}
+
+double DarkBremAnalyticModel::SampleW(double x, double w_max) const {
+  static const double MA =
+      G4APrime::APrime()->GetPDGMass() / CLHEP::GeV; // mass A' in GeV
+  static const double Mel =
+      G4Electron::Electron()->GetPDGMass() / CLHEP::GeV; // mass electron in GeV
+
+  // with s = y/c and w = s/(1+s), A12 becomes a - k (w(1-w) + r(1-w)^2)
+  double c = MA * MA * (1. - x) / x + Mel * Mel * x;
+  double a = 1. - x + x * x / 2.;
+  double k = x * (1. - x) * MA * MA / c;
+  double r = Mel * Mel * x / c;
+  auto cdf = [&](double w) {
+    double v = 1. - w;
+    return a * w -
+           k * (w * w / 2. - w * w * w / 3. + r * (1. - v * v * v) / 3.);
+  };
+  auto pdf = [&](double w) {
+    double v = 1. - w;
+    return a - k * (w * v + r * v * v);
+  };
+
+  // Newton's method on the monotonic cubic, kept inside the bracket
+  double target = G4UniformRand() * cdf(w_max);
+  double low = 0., high = w_max, w = target / cdf(w_max) * w_max;
+  for (int i = 0; i < 50; i++) {
+    double f = cdf(w) - target;
+    if (std::abs(f) <= 1e-12 * target) break;
+    if (f < 0.)
+      low = w;
+    else
+      high = w;
+    double step = w - f / pdf(w);
+    w = (step > low and step < high) ? step : 0.5 * (low + high);
+  }
+  return w;
+}
+
+} // namespace darkbrem
+} // namespace g4fire
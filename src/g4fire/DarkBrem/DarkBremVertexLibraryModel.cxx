@@ -1,17 +1,18 @@
 #include "g4fire/DarkBrem/DarkBremVertexLibraryModel.h"
 
-#include <dirent.h>
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <algorithm>
+#include <limits>
+#include <sstream>
 #include <string>
 
-#include <boost/numeric/odeint.hpp>
-
 #include "fire/exception/Exception.h"
 //#include "Framework/Logger.h"
 
 #include "g4fire/DarkBrem/G4APrime.h"
+#include "g4fire/DarkBrem/WeizsackerWilliams.h"
 
 #include "G4Electron.hh"
 #include "G4EventManager.hh"
@@ -46,7 +47,8 @@ DarkBremVertexLibraryModel::DarkBremVertexLibraryModel(
   epsilon_ = params.get<double>("epsilon");
 
   library_path_ = params.get<std::string>("library_path");
-  SetMadGraphDataLibrary(library_path_);
+  library_ = std::make_unique<VertexLibrary>(
+      library_path_, G4APrime::APrime()->GetPDGMass() / CLHEP::GeV);
 }
 
 void DarkBremVertexLibraryModel::PrintInfo() const {
@@ -64,92 +66,35 @@ void DarkBremVertexLibraryModel::RecordConfig(fire::RunHeader &h) const {
   h.set<std::string>("Vertex Library", library_path_);
 }
 
-G4double
-DarkBremVertexLibraryModel::ComputeCrossSectionPerAtom(G4double electron_ke,
-                                                       G4double A, G4double Z) {
-  static const double MA =
-      G4APrime::APrime()->GetPDGMass() / CLHEP::GeV; // mass A' in GeV
-  static const double Mel =
-      G4Electron::Electron()->GetPDGMass() / CLHEP::GeV; // mass electron in GeV
+std::string DarkBremVertexLibraryModel::CacheKey() const {
+  std::ostringstream key;
+  key << "vertex_library_threshold" << threshold_ << "_epsilon" << epsilon_;
+  return key.str();
+}
+
+G4double DarkBremVertexLibraryModel::GetThreshold() const {
+  return threshold_ * CLHEP::GeV;
+}
+
+G4double DarkBremVertexLibraryModel::ComputeCrossSectionPerAtom(
+    G4double electron_ke, G4double A, G4double Z) {
+  return ComputeCrossSectionPerAtomAtMass(electron_ke, A, Z,
+                                          G4APrime::APrime()->GetPDGMass());
+}
+
+G4double DarkBremVertexLibraryModel::ComputeCrossSectionPerAtomAtMass(
+    G4double electron_ke, G4double A, G4double Z, G4double ap_mass) {
+  double MA = ap_mass / CLHEP::GeV; // mass A' in GeV
 
   if (electron_ke < keV)
     return 0.; // outside viable region for model
 
   electron_ke = electron_ke / CLHEP::GeV; // Change energy to GeV.
 
-  // TODO move to first cut above
-  if (electron_ke < threshold_)
+  if (electron_ke < std::max(threshold_, 2. * MA))
     return 0.; // can't produce a prime
 
-  // begin: chi-formfactor calculation
-  Chi chiformfactor;
-  //  set parameters
-  chiformfactor.A = A;
-  chiformfactor.Z = Z;
-  chiformfactor.E0 = electron_ke;
-  chiformfactor.MA = MA;
-  chiformfactor.Mel = Mel;
-
-  double tmin = MA * MA * MA * MA / (4. * electron_ke * electron_ke);
-  double tmax = MA * MA;
-
-  // Integrate over chi.
-  StateType integral(1);
-  integral[0] = 0.; // start integral value at zero
-  boost::numeric::odeint::integrate(
-      chiformfactor // how to calculate integrand
-      ,
-      integral // integral result
-      ,
-      tmin // integral lower limit
-      ,
-      tmax // integral upper limit
-      ,
-      (tmax - tmin) / 1000 // dt - initial, adapts based off error
-  );
-
-  G4double ChiRes = integral[0];
-
-  // Integrate over x. Can use log approximation instead, which falls off at
-  // high A' mass.
-  DiffCross diffcross;
-  diffcross.E0 = electron_ke;
-  diffcross.MA = MA;
-  diffcross.Mel = Mel;
-
-  double xmin = 0;
-  double xmax = 1;
-  if ((Mel / electron_ke) > (MA / electron_ke))
-    xmax = 1 - Mel / electron_ke;
-  else
-    xmax = 1 - MA / electron_ke;
-
-  // Integrate over differential cross section.
-  integral[0] = 0.; // start integral value at zero
-  boost::numeric::odeint::integrate(
-      diffcross // how to calculate integrand
-      ,
-      integral // integral result
-      ,
-      xmin // integral lower limit
-      ,
-      xmax // integral upper limit
-      ,
-      (xmax - xmin) / 1000 // dx - initial, adapts based off error
-  );
-
-  G4double DsDx = integral[0];
-
-  G4double GeVtoPb = 3.894E08;
-  G4double alphaEW = 1.0 / 137.0;
-
-  G4double cross = GeVtoPb * 4. * alphaEW * alphaEW * alphaEW * epsilon_ *
-                   epsilon_ * ChiRes * DsDx * CLHEP::picobarn;
-
-  if (cross < 0.)
-    return 0.; // safety check all the math
-
-  return cross;
+  return ww::CrossSectionPerAtom(electron_ke, A, Z, MA, epsilon_);
 }
 
 void DarkBremVertexLibraryModel::GenerateChange(
@@ -176,33 +121,9 @@ void DarkBremVertexLibraryModel::GenerateChange(
   double P = sqrt(EAcc * EAcc - Mel * Mel);
   // double PhiAcc = data.electron.Phi();
   double phi_acc{Phi(data.electron)};
-  if (method_ == DarkBremMethod::forward_only) {
-    unsigned int i = 0;
-    while (pt * pt + Mel * Mel > EAcc * EAcc) {
-      // Skip events until the transverse energy is less than the total energy.
-      i++;
-      data = GetMadgraphData(incident_energy);
-      // EAcc = (data.electron.E() - Mel) *
-      EAcc = (data.electron.w() - Mel) *
-                 ((incident_energy - Mel - MA) / (data.E - Mel - MA)) +
-             Mel;
-      // pt = data.electron.Pt();
-      pt = Pt(data.electron);
-      P = sqrt(EAcc * EAcc - Mel * Mel);
-      // PhiAcc = data.electron.Phi();
-      phi_acc = Phi(data.electron);
-
-      if (i > max_iterations_) {
-        // ldmx_log(warn)
-        //    << "Could not produce a realistic vertex with library energy "
-        //    << data.electron.E() << " MeV.\n"
-        //    << "Consider expanding your libary of A' vertices to include a "
-        //       "beam energy closer to "
-        //    << incident_energy << " MeV.";
-        break;
-      }
-    }
-  } else if (method_ == DarkBremMethod::cm_scaling) {
+  // forward_only keeps the scaled kinematics above, the event it sampled
+  // is valid at this energy
+  if (method_ == DarkBremMethod::cm_scaling) {
 
     // TLorentzVector el(data.electron.X(), data.electron.Y(),
     // data.electron.Z(),
@@ -252,7 +173,8 @@ void DarkBremVertexLibraryModel::GenerateChange(
       sqrt(EAcc * EAcc -
            electron_mass_c2 * electron_mass_c2); // Electron momentum in MeV.
   G4ThreeVector recoil_e_p;
-  double theta_acc = std::asin(pt / P);
+  // guard against rounding when the event is right at its validity limit
+  double theta_acc = std::asin(std::min(1., pt / P));
   recoil_e_p.set(std::sin(theta_acc) * std::cos(phi_acc),
                  std::sin(theta_acc) * std::sin(phi_acc), std::cos(theta_acc));
   recoil_e_p.rotateUz(track.GetMomentumDirection());
@@ -288,192 +210,121 @@ void DarkBremVertexLibraryModel::GenerateChange(
   }
 }
 
-void DarkBremVertexLibraryModel::SetMadGraphDataLibrary(std::string path) {
-  // Assumptions:
-  //  - Directory passed is a flat directory (no sub directories) containing LHE
-  //  files
-  //  - LHE files are events generated with the correct mass point
-  // TODO automatically select LHE files of the correct mass point?
-
-  bool found_one_file = false;
-  DIR *dir;           // handle to opened directory
-  struct dirent *ent; // handle to entry inside directory
-  if ((dir = opendir(path.c_str())) != NULL) {
-    // directory can be opened
-    while ((ent = readdir(dir)) != NULL) {
-      std::string fp = path + '/' + std::string(ent->d_name);
-      if (fp.substr(fp.find_last_of('.') + 1) == "lhe") {
-        // file ends in '.lhe'
-        ParseLHE(fp);
-        found_one_file = true;
-      }
-    }
-    closedir(dir);
-  }
-
-  if (!found_one_file) {
-    throw fire::Exception("DirDNE",
-                          "Directory '" + path +
-                              "' was unable to be opened or no '.lhe' "
-                              "files were found inside of it.",
-                          false);
-  }
-
-  MakePlaceholders(); // Setup the placeholder offsets for getting data.
-
-  // ldmx_log(info) << "MadGraph Library of Dark Brem Vertices:\n";
-  for (const auto &kV : mad_graph_data_) {
-    // ldmx_log(info) << "\t" << std::setw(8) << kV.first << " GeV Beam -> "
-    //               << std::setw(6) << kV.second.size() << " Events";
+void DarkBremVertexLibraryModel::MakePlaceholders() {
+  current_data_points_.clear();
+  for (std::size_t i_bin = 0; i_bin < library_->size(); i_bin++) {
+    auto count{library_->bin(i_bin).count};
+    current_data_points_.push_back(int(G4UniformRand() * count));
   }
-
-  return;
 }
 
-void DarkBremVertexLibraryModel::Chi::operator()(const StateType &,
-                                                 StateType &dxdt, double t) {
-  G4double MUp = 2.79;  // mass up quark [GeV]
-  G4double Mpr = 0.938; // mass proton [GeV]
-
-  G4double d = 0.164 / pow(A, 2. / 3.);
-  G4double ap = 773.0 / (Mel * pow(Z, 2. / 3.));
-  G4double a = 111.0 / (Mel * pow(Z, 1. / 3.));
-  G4double G2el = pow(Z, 2) * pow(a, 4) * pow(t, 2) /
-                  (pow(1.0 + a * a * t, 2) * pow(1.0 + t / d, 2));
-  G4double G2in = Z * pow(ap, 4) * pow(t, 2) /
-                  (pow(1.0 + ap * ap * t, 2) * pow(1.0 + t / 0.71, 8)) *
-                  pow(1.0 + t * (pow(MUp, 2) - 1.0) / (4.0 * pow(Mpr, 2)), 2);
-  G4double G2 = G2el + G2in;
-  G4double ttmin = MA * MA * MA * MA / 4.0 / E0 / E0;
-  G4double Under = G2 * (t - ttmin) / t / t;
-
-  dxdt[0] = Under;
-
-  return;
-}
-
-void DarkBremVertexLibraryModel::DiffCross::operator()(const StateType &,
-                                                       StateType &dsigma_dx,
-                                                       double x) {
-  G4double beta = sqrt(1 - MA * MA / E0 / E0);
-  G4double num = 1. - x + x * x / 3.;
-  G4double denom = MA * MA * (1. - x) / x + Mel * Mel * x;
-
-  dsigma_dx[0] = beta * num / denom;
-
-  return;
-}
-
-void DarkBremVertexLibraryModel::ParseLHE(std::string fname) {
+void DarkBremVertexLibraryModel::PrepareLibrary() {
   static const double MA =
       G4APrime::APrime()->GetPDGMass() / CLHEP::GeV; // mass A' in GeV
+  static const double Mel =
+      G4Electron::Electron()->GetPDGMass() / CLHEP::GeV; // mass electron in GeV
 
-  // TODO: use already written LHE parser?
-  // ldmx_log(info) << "Parsing LHE file '" << fname << "'... ";
-
-  std::ifstream ifile;
-  ifile.open(fname.c_str());
-  if (!ifile) {
-    throw fire::Exception("LHEFile", "Unable to open LHE file '" + fname + "'.",
-                          false);
+  MakePlaceholders();
+
+  bin_energies_.clear();
+  for (std::size_t i_bin = 0; i_bin < library_->size(); i_bin++)
+    bin_energies_.push_back(library_->bin(i_bin).energy);
+
+  min_energies_.clear();
+  valid_order_.clear();
+  min_energy_offsets_.clear();
+  if (method_ != DarkBremMethod::forward_only)
+    return;
+
+  for (std::size_t i_bin = 0; i_bin < library_->size(); i_bin++) {
+    const auto &bin{library_->bin(i_bin)};
+    // the offsets of the bins of an indexed library point into their own
+    // files, so the entries of each bin are located by a running offset
+    min_energy_offsets_.push_back(min_energies_.size());
+    const auto *vertices{library_->vertices(bin)};
+    std::vector<std::pair<double, uint32_t>> bin_min_energies;
+    bin_min_energies.reserve(bin.count);
+    for (uint32_t i_event = 0; i_event < bin.count; i_event++) {
+      const auto *electron{vertices[i_event].electron};
+      double pt2 = double(electron[0]) * electron[0] +
+                   double(electron[1]) * electron[1];
+      double kinetic = double(electron[3]) - Mel;
+      double min_energy = kinetic > 0.
+                              ? Mel + MA +
+                                    (sqrt(pt2 + Mel * Mel) - Mel) *
+                                        (bin.energy - Mel - MA) / kinetic
+                              : std::numeric_limits<double>::max();
+      bin_min_energies.emplace_back(min_energy, i_event);
+    }
+    std::sort(bin_min_energies.begin(), bin_min_energies.end());
+    for (const auto &[min_energy, i_event] : bin_min_energies) {
+      min_energies_.push_back(min_energy);
+      valid_order_.push_back(i_event);
+    }
   }
-
-  std::string line;
-  while (std::getline(ifile, line)) {
-    std::istringstream iss(line);
-    int ptype, state;
-    double skip, px, py, pz, E, M;
-    if (iss >> ptype >> state >> skip >> skip >> skip >> skip >> px >> py >>
-        pz >> E >> M) {
-      if ((ptype == 11) && (state == -1)) {
-        double ebeam = E;
-        double e_px, e_py, e_pz, a_px, a_py, a_pz, e_E, a_E, e_M, a_M;
-        for (int i = 0; i < 2; i++) {
-          std::getline(ifile, line);
-        }
-        std::istringstream jss(line);
-        jss >> ptype >> state >> skip >> skip >> skip >> skip >> e_px >> e_py >>
-            e_pz >> e_E >> e_M;
-        if ((ptype == 11) && (state == 1)) { // Find a final state electron.
-          for (int i = 0; i < 2; i++) {
-            std::getline(ifile, line);
-          }
-          std::istringstream kss(line);
-          kss >> ptype >> state >> skip >> skip >> skip >> skip >> a_px >>
-              a_py >> a_pz >> a_E >> a_M;
-          if (ptype == 622 and state == 1) {
-            if (abs(1. - a_M / MA) > 1e-3) {
-              throw fire::Exception("BadMGEvnt",
-                              "A MadGraph imported event has a different "
-                              "APrime mass than the model has (MadGraph = " +
-                                  std::to_string(a_M) + "GeV; Model = " +
-                                  std::to_string(MA) + "GeV).",
-                              false);
-            }
-            OutgoingKinematics evnt;
-            double cmpx = a_px + e_px;
-            double cmpy = a_py + e_py;
-            double cmpz = a_pz + e_pz;
-            double cmE = a_E + e_E;
-            evnt.electron << e_px, e_py, e_pz, e_E;
-            // evnt.electron = TLorentzVector(e_px, e_py, e_pz, e_E);
-            // evnt.center_momentum = TLorentzVector(cmpx, cmpy, cmpz, cmE);
-            evnt.center_momentum << cmpx, cmpy, cmpz, cmE;
-            evnt.E = ebeam;
-            mad_graph_data_[ebeam].push_back(evnt);
-          } // get a prime kinematics
-        }   // check for final state
-      }     // check for particle type and state
-    }       // able to get momentum/energy numbers
-  }         // while getting lines
-  // Add the energy to the list, with a random offset between 0 and the total
-  // number of entries.
-  ifile.close();
-  // ldmx_log(info) << "done parsing.";
 }
 
-void DarkBremVertexLibraryModel::MakePlaceholders() {
-  current_data_points_.clear();
-  max_iterations_ = 10000;
-  for (const auto &iter : mad_graph_data_) {
-    current_data_points_[iter.first] =
-        int(G4UniformRand() * iter.second.size());
-    if (iter.second.size() < max_iterations_)
-      max_iterations_ = iter.second.size();
-  }
+std::size_t DarkBremVertexLibraryModel::CountValidEvents(std::size_t i_bin,
+                                                        double E0) const {
+  // the events valid at E0 are the ones with a lower minimum energy
+  auto begin{min_energies_.begin() + min_energy_offsets_[i_bin]};
+  return std::upper_bound(begin, begin + library_->bin(i_bin).count, E0) -
+         begin;
 }
 
 DarkBremVertexLibraryModel::OutgoingKinematics
 DarkBremVertexLibraryModel::GetMadgraphData(double E0) {
   OutgoingKinematics cmdata; // data frame to return
 
-  // Cycle through imported beam energies until the closest one above is found,
-  // or the max is reached.
-  double samplingE = 0.;
-  for (const auto &keyVal : current_data_points_) {
-    samplingE = keyVal.first; // move samplingE up
-    // check if went under the sampling energy
-    //  the map is sorted by key, so we can be done right after E0 goes under
-    //  samplingE
-    if (E0 < samplingE)
-      break;
-  }
-  // now samplingE is the closest energy above E0 or the maximum energy imported
-  // from mad graph
-
-  // Need to loop around if we hit the end, when the size of
-  // mad_graph_data_[samplingE] is smaller than
-  //  the number of events we want
-  if (current_data_points_.at(samplingE) >=
-      mad_graph_data_.at(samplingE).size()) {
-    current_data_points_[samplingE] = 0;
-  }
+  // the library is loaded and prepared on the first dark brem
+  if (bin_energies_.empty())
+    PrepareLibrary();
 
-  // Get the lorentz vectors from the index given by the placeholder.
-  cmdata = mad_graph_data_.at(samplingE).at(current_data_points_.at(samplingE));
+  // Find the closest imported beam energy above E0, or the max if there is
+  // none above.
+  std::size_t i_bin = std::min<std::size_t>(
+      std::upper_bound(bin_energies_.begin(), bin_energies_.end(), E0) -
+          bin_energies_.begin(),
+      bin_energies_.size() - 1);
+
+  uint32_t i_event;
+  if (method_ == DarkBremMethod::forward_only) {
+    // fall back to the closest bins below E0 if none of the events
+    // of this bin are valid at E0
+    std::size_t i_valid_bin{i_bin};
+    std::size_t n_valid{CountValidEvents(i_valid_bin, E0)};
+    while (n_valid == 0 and i_valid_bin > 0)
+      n_valid = CountValidEvents(--i_valid_bin, E0);
+    if (n_valid == 0) {
+      G4cout << "[ DarkBremVertexLibraryModel ]: No vertex in the library "
+             << "is valid at " << E0 << " GeV, using the one closest to "
+             << "being valid in the bin at " << bin_energies_[i_bin]
+             << " GeV. Consider expanding the library to include a beam "
+             << "energy closer to " << E0 << " GeV." << G4endl;
+      n_valid = 1;
+    } else {
+      i_bin = i_valid_bin;
+    }
+    i_event = valid_order_[min_energy_offsets_[i_bin] +
+                           std::min<std::size_t>(G4UniformRand() * n_valid,
+                                                 n_valid - 1)];
+  } else {
+    // Need to loop around if we hit the end, when the size of
+    // the bin is smaller than the number of events we want
+    if (current_data_points_[i_bin] >= library_->bin(i_bin).count) {
+      current_data_points_[i_bin] = 0;
+    }
+    // Get the event from the index given by the placeholder
+    // and increment it.
+    i_event = current_data_points_[i_bin]++;
+  }
 
-  // Increment the current index
-  current_data_points_[samplingE]++;
+  const auto &bin{library_->bin(i_bin)};
+  const auto &vertex{library_->vertices(bin)[i_event]};
+  cmdata.electron = Eigen::Map<const Eigen::Vector4f>(vertex.electron);
+  cmdata.center_momentum =
+      Eigen::Map<const Eigen::Vector4f>(vertex.center_momentum);
+  cmdata.E = bin.energy;
 
   return cmdata;
 }
@@ -1,15 +1,29 @@
 #include "g4fire/DarkBrem/G4eDarkBremsstrahlung.h"
 
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
 #include "fire/RunHeader.h"
+#include "fire/exception/Exception.h"
 
 #include "G4Electron.hh"      //for electron definition
 #include "G4EventManager.hh"  //for EventID number
-#include "G4ProcessTable.hh"  //for deactivating dark brem process
 #include "G4ProcessType.hh"   //for type of process
+#include "G4ProductionCutsTable.hh"  //for materials in use
 #include "G4RunManager.hh"    //for VerboseLevel
 
+#include "g4fire/DarkBrem/DarkBremAnalyticModel.h"
 #include "g4fire/DarkBrem/DarkBremVertexLibraryModel.h"
 #include "g4fire/DarkBrem/G4APrime.h"
+#include "g4fire/ProcessActivationManager.h"
+#include "g4fire/UserEventInformation.h"
 
 namespace g4fire {
 namespace darkbrem {
@@ -22,11 +36,74 @@ G4double ElementXsecCache::get(G4double energy, G4double A, G4double Z) {
       //                "ElementXsecCache not given a model to calculate cross "
       //                "sections with.");
     }
-    the_cache_[key] = model_->ComputeCrossSectionPerAtom(energy, A, Z);
+    the_cache_[key] =
+        ap_mass_ > 0.
+            ? model_->ComputeCrossSectionPerAtomAtMass(energy, A, Z, ap_mass_)
+            : model_->ComputeCrossSectionPerAtom(energy, A, Z);
+    modified_ = true;
   }
   return the_cache_.at(key);
 }
 
+std::size_t ElementXsecCache::load(const std::string& file_name) {
+  std::ifstream file(file_name);
+  if (!file) return 0;
+
+  // the file is what stream writes, skip the header line
+  std::string line;
+  std::getline(file, line);
+
+  std::map<key_t, G4double> loaded;
+  while (std::getline(file, line)) {
+    if (line.empty()) continue;
+    std::istringstream iss(line);
+    key_t A, Z, E;
+    G4double xsec;
+    char comma;
+    if (!(iss >> A >> comma >> Z >> comma >> E >> comma >> xsec)) {
+      // partial or foreign file, recalculate instead of trusting any of it
+      return 0;
+    }
+    loaded[computeKey(E, A, Z)] = xsec * CLHEP::picobarn;
+  }
+
+  // the cross sections calculated so far take precedence
+  the_cache_.insert(loaded.begin(), loaded.end());
+  return loaded.size();
+}
+
+void ElementXsecCache::save(const std::string& file_name) {
+  if (!modified_) return;
+
+  // serialize the jobs sharing the cache, the lock is released when the
+  // descriptor is closed (also if this job dies while holding it)
+  int lock = ::open((file_name + ".lock").c_str(), O_RDWR | O_CREAT, 0666);
+  if (lock < 0) return;
+  if (::flock(lock, LOCK_EX) != 0) {
+    ::close(lock);
+    return;
+  }
+
+  // another job may have saved since we loaded, merge in its cross sections
+  // so they are not lost when the file is replaced
+  load(file_name);
+
+  std::string tmp_name{file_name + ".tmp" + std::to_string(getpid())};
+  bool written{false};
+  {
+    std::ofstream file(tmp_name, std::ios::trunc);
+    stream(file);
+    written = file.good();
+  }
+
+  if (!written or ::rename(tmp_name.c_str(), file_name.c_str()) != 0)
+    ::remove(tmp_name.c_str());
+  else
+    modified_ = false;
+
+  ::close(lock);
+}
+
 void ElementXsecCache::stream(std::ostream& o) const {
   o << "A [au],Z [protons],Energy [MeV],Xsec [pb]\n"
     << std::setprecision(std::numeric_limits<double>::digits10 +
@@ -62,11 +139,20 @@ G4eDarkBremsstrahlung::G4eDarkBremsstrahlung(
   only_one_per_event_ = params.get<bool>("only_one_per_event");
   cache_xsec_ = params.get<bool>("cache_xsec");
   ap_mass_ = params.get<double>("ap_mass");
+  auto xsec_cache_dir{params.get<std::string>("xsec_cache_dir", "")};
+  reweight_masses_ =
+      params.get<std::vector<double>>("reweight_masses", {});
+  xsec_table_max_energy_ =
+      params.get<double>("xsec_table_max_energy", 100. * GeV);
+  xsec_table_bins_per_decade_ =
+      params.get<int>("xsec_table_bins_per_decade", 50);
 
   auto model{params.get<fire::config::Parameters>("model")};
   auto model_name{model.get<std::string>("name")};
   if (model_name == "vertex_library") {
     model_ = std::make_shared<DarkBremVertexLibraryModel>(model);
+  } else if (model_name == "analytic") {
+    model_ = std::make_shared<DarkBremAnalyticModel>(model);
   } else {
     //EXCEPTION_RAISE("DarkBremModel",
     //                "Model named '" + model_name + "' is not known.");
@@ -77,8 +163,25 @@ G4eDarkBremsstrahlung::G4eDarkBremsstrahlung(
   if (cache_xsec_) {
     element_xsec_cache_ =
         ElementXsecCache(model_);  // remake cache with model attached
-    CalculateCommonXsec();         // calculate common cross sections
+    if (xsec_cache_dir.empty()) {
+      CalculateCommonXsec();  // calculate common cross sections
+    } else {
+      // the file is filled in lazily over the runs using it, so there is
+      // no need to calculate the common cross sections up front
+      std::ostringstream file_name;
+      file_name << xsec_cache_dir << "/dark_brem_xsec_mass" << ap_mass_ << "_"
+                << model_->CacheKey() << ".csv";
+      xsec_cache_file_ = file_name.str();
+      element_xsec_cache_.load(xsec_cache_file_);
+    }
   }
+
+  for (double mass : reweight_masses_)
+    reweight_caches_.emplace_back(model_, mass * MeV);
+}
+
+G4eDarkBremsstrahlung::~G4eDarkBremsstrahlung() {
+  if (!xsec_cache_file_.empty()) element_xsec_cache_.save(xsec_cache_file_);
 }
 
 G4bool G4eDarkBremsstrahlung::IsApplicable(const G4ParticleDefinition& p) {
@@ -101,10 +204,11 @@ void G4eDarkBremsstrahlung::RecordConfig(fire::RunHeader& h) const {
 G4VParticleChange* G4eDarkBremsstrahlung::PostStepDoIt(const G4Track& track,
                                                        const G4Step& step) {
   // Debugging Purposes: Check if track we get is an electron
-  if (not IsApplicable(*track.GetParticleDefinition()))
-    //EXCEPTION_RAISE(
-    //    "DBBadTrack",
-    //    "Dark brem process receieved a track that isn't applicable.");
+  if (not IsApplicable(*track.GetParticleDefinition())) {
+    throw fire::Exception(
+        "DBBadTrack",
+        "Dark brem process receieved a track that isn't applicable.", false);
+  }
 
   /*
    * Geant4 has decided that it is our time to interact,
@@ -116,23 +220,20 @@ G4VParticleChange* G4eDarkBremsstrahlung::PostStepDoIt(const G4Track& track,
     // Deactivate the process after one dark brem if we restrict ourselves to
     // only one per event. If this is in the stepping action instead, more than
     // one brem can occur within each step. Reactivated in
-    // RunManager::TerminateOneEvent Both biased and unbiased process could be
-    // in the run (but not at the same time),
-    //  so we turn off both while silencing the warnings from the process table.
-    std::vector<G4String> db_process_name_options = {
-        "biasWrapper(" + PROCESS_NAME + ")", PROCESS_NAME};
-    G4ProcessTable* ptable = G4ProcessTable::GetProcessTable();
-    G4int verbosity = ptable->GetVerboseLevel();
-    ptable->SetVerboseLevel(0);
-    for (auto const& name : db_process_name_options)
-      ptable->SetProcessActivation(name, false);
-    ptable->SetVerboseLevel(verbosity);
+    // RunManager::TerminateOneEvent. The biasing wrapper (if there is one) was
+    // resolved along with this process in BuildPhysicsTable.
+    ProcessActivationManager::getInstance().deactivate(this);
   }
 
   aParticleChange.Initialize(track);
 
   model_->GenerateChange(aParticleChange, track, step);
 
+  // the models add the A' first
+  if (not reweight_masses_.empty())
+    RecordForReweighting(track,
+                         aParticleChange.GetSecondary(0)->GetTotalEnergy());
+
   /*
    * Parent class has some internal counters that need to be reset,
    * so we call it before returning. It will return our shared
@@ -141,6 +242,37 @@ G4VParticleChange* G4eDarkBremsstrahlung::PostStepDoIt(const G4Track& track,
   return G4VDiscreteProcess::PostStepDoIt(track, step);
 }
 
+void G4eDarkBremsstrahlung::BuildPhysicsTable(
+    const G4ParticleDefinition& particle) {
+  if (only_one_per_event_)
+    ProcessActivationManager::getInstance().resolve(this, particle);
+
+  xsec_tables_.clear();
+  xsec_tables_.resize(G4Material::GetNumberOfMaterials());
+
+  G4double min_energy = std::max(model_->GetThreshold(), keV);
+  if (min_energy >= xsec_table_max_energy_) return;
+
+  std::size_t num_bins = std::max<std::size_t>(
+      1, std::ceil(xsec_table_bins_per_decade_ *
+                   std::log10(xsec_table_max_energy_ / min_energy)));
+
+  const G4ProductionCutsTable* couples =
+      G4ProductionCutsTable::GetProductionCutsTable();
+  for (std::size_t i = 0; i < couples->GetTableSize(); i++) {
+    const G4Material* material =
+        couples->GetMaterialCutsCouple(i)->GetMaterial();
+    auto& table{xsec_tables_[material->GetIndex()]};
+    if (table) continue;  // several couples can share a material
+    table = std::make_unique<G4PhysicsLogVector>(
+        min_energy, xsec_table_max_energy_, num_bins);
+    for (std::size_t i_bin = 0; i_bin <= num_bins; i_bin++) {
+      table->PutValue(i_bin, ComputeCrossSectionPerVolume(
+                                 material, table->Energy(i_bin)));
+    }
+  }
+}
+
 void G4eDarkBremsstrahlung::CalculateCommonXsec() {
   // first in pair is A, second is Z
   std::vector<std::pair<G4double, G4double>> elements = {
@@ -164,28 +296,84 @@ G4double G4eDarkBremsstrahlung::GetMeanFreePath(const G4Track& track, G4double,
   if (not IsApplicable(*track.GetParticleDefinition())) return DBL_MAX;
 
   G4Material* materialWeAreIn = track.GetMaterial();
-  const G4ElementVector* theElementVector = materialWeAreIn->GetElementVector();
-  const G4double* NbOfAtomsPerVolume =
-      materialWeAreIn->GetVecNbOfAtomsPerVolume();
+  G4double energy = track.GetDynamicParticle()->GetKineticEnergy();
+  if (energy < model_->GetThreshold()) return DBL_MAX;
+
+  G4double SIGMA;
+  std::size_t i_material = materialWeAreIn->GetIndex();
+  if (i_material < xsec_tables_.size() and xsec_tables_[i_material] and
+      energy <= xsec_table_max_energy_)
+    SIGMA = xsec_tables_[i_material]->Value(energy);
+  else
+    SIGMA = ComputeCrossSectionPerVolume(materialWeAreIn, energy);
+
+  return SIGMA > DBL_MIN ? 1. / SIGMA : DBL_MAX;
+}
+
+G4double G4eDarkBremsstrahlung::ComputeCrossSectionPerVolume(
+    const G4Material* material, G4double energy) {
+  const G4ElementVector* theElementVector = material->GetElementVector();
+  const G4double* NbOfAtomsPerVolume = material->GetVecNbOfAtomsPerVolume();
 
   G4double SIGMA = 0;
-  for (size_t i = 0; i < materialWeAreIn->GetNumberOfElements(); i++) {
+  for (size_t i = 0; i < material->GetNumberOfElements(); i++) {
     G4double AtomicZ = (*theElementVector)[i]->GetZ();
     G4double AtomicA = (*theElementVector)[i]->GetA() / (g / mole);
-    G4double energy = track.GetDynamicParticle()->GetKineticEnergy();
 
-    G4double element_xsec;
+    SIGMA += NbOfAtomsPerVolume[i] * GetElementXsec(energy, AtomicA, AtomicZ);
+  }
+
+  return SIGMA;
+}
+
+G4double G4eDarkBremsstrahlung::GetElementXsec(G4double energy, G4double A,
+                                               G4double Z) {
+  if (cache_xsec_) return element_xsec_cache_.get(energy, A, Z);
+  return model_->ComputeCrossSectionPerAtom(energy, A, Z);
+}
+
+void G4eDarkBremsstrahlung::RecordForReweighting(const G4Track& track,
+                                                 G4double aprime_energy) {
+  const G4Material* material = track.GetMaterial();
+  const G4ElementVector* elements = material->GetElementVector();
+  const G4double* NbOfAtomsPerVolume = material->GetVecNbOfAtomsPerVolume();
+  G4double energy = track.GetKineticEnergy();
+
+  std::vector<G4double> contributions;
+  G4double SIGMA = 0;
+  for (size_t i = 0; i < material->GetNumberOfElements(); i++) {
+    SIGMA += NbOfAtomsPerVolume[i] *
+             GetElementXsec(energy, (*elements)[i]->GetA() / (g / mole),
+                            (*elements)[i]->GetZ());
+    contributions.push_back(SIGMA);
+  }
+
+  G4double chosen = G4UniformRand() * SIGMA;
+  std::size_t i_element = 0;
+  while (i_element + 1 < contributions.size() and
+         contributions[i_element] <= chosen)
+    i_element++;
 
-    if (cache_xsec_)
-      element_xsec = element_xsec_cache_.get(energy, AtomicA, AtomicZ);
-    else
-      element_xsec =
-          model_->ComputeCrossSectionPerAtom(energy, AtomicA, AtomicZ);
+  g4fire::UserEventInformation::DarkBrem dark_brem;
+  dark_brem.incident_energy = energy;
+  dark_brem.atomic_a = (*elements)[i_element]->GetA() / (g / mole);
+  dark_brem.atomic_z = (*elements)[i_element]->GetZ();
+  dark_brem.aprime_energy = aprime_energy;
 
-    SIGMA += NbOfAtomsPerVolume[i] * element_xsec;
+  G4double xsec =
+      GetElementXsec(energy, dark_brem.atomic_a, dark_brem.atomic_z);
+  std::map<double, double> mass_weights;
+  for (std::size_t i = 0; i < reweight_masses_.size(); i++) {
+    mass_weights[reweight_masses_[i]] =
+        xsec > 0. ? reweight_caches_[i].get(energy, dark_brem.atomic_a,
+                                            dark_brem.atomic_z) /
+                        xsec
+                  : 0.;
   }
 
-  return SIGMA > DBL_MIN ? 1. / SIGMA : DBL_MAX;
+  static_cast<g4fire::UserEventInformation*>(
+      G4EventManager::GetEventManager()->GetUserInformation())
+      ->addDarkBrem(dark_brem, mass_weights);
 }
 }  // namespace darkbrem
 }  // namespace g4fire
@@ -0,0 +1,426 @@
+#include "g4fire/DarkBrem/VertexLibrary.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <set>
+#include <sstream>
+
+#include "fire/exception/Exception.h"
+
+namespace g4fire {
+namespace darkbrem {
+
+namespace {
+
+/// identifies a binary vertex library
+const char MAGIC[8] = {'G', '4', 'F', 'D', 'B', 'L', 'I', 'B'};
+
+/// version of the binary layout written by this code
+const uint32_t VERSION = 1;
+
+/**
+ * Header at the start of a binary vertex library.
+ *
+ * The bins follow the header and the vertices follow the bins.
+ */
+struct FileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t num_bins;
+  /// mass of the A' [GeV]
+  double aprime_mass;
+  uint64_t num_vertices;
+};
+
+/**
+ * @param[in] path a path
+ * @param[in] extension an extension including the leading dot
+ * @return true if the path ends in the extension
+ */
+bool hasExtension(const std::string &path, const std::string &extension) {
+  return path.size() > extension.size() &&
+         path.compare(path.size() - extension.size(), extension.size(),
+                      extension) == 0;
+}
+
+/**
+ * Read the header and bins of a binary library without mapping it.
+ *
+ * @param[in] file_name path to the binary library
+ * @param[out] header header of the library
+ * @param[out] bins bins of the library
+ * @returns false if the file can't be read or isn't a library
+ */
+bool readBins(const std::string &file_name, FileHeader &header,
+              std::vector<VertexLibrary::Bin> &bins) {
+  std::ifstream file(file_name, std::ios::binary);
+  if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) or
+      std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 or
+      header.version != VERSION)
+    return false;
+  bins.resize(header.num_bins);
+  return bool(file.read(reinterpret_cast<char *>(bins.data()),
+                        bins.size() * sizeof(VertexLibrary::Bin)));
+}
+
+}  // namespace
+
+const std::string VertexLibrary::INDEX_NAME = "index.dbidx";
+
+VertexLibrary::VertexLibrary(const std::string &path, double aprime_mass)
+    : aprime_mass_(aprime_mass) {
+  if (hasExtension(path, ".dbidx") or
+      access((path + '/' + INDEX_NAME).c_str(), R_OK) == 0) {
+    index_file_ = hasExtension(path, ".dbidx") ? path : path + '/' + INDEX_NAME;
+    if (access(index_file_.c_str(), R_OK) != 0) {
+      throw fire::Exception("FileDNE",
+                            "Vertex library index '" + index_file_ +
+                                "' can't be read.",
+                            false);
+    }
+    return;
+  }
+
+  if (hasExtension(path, ".dblib")) {
+    binary_file_ = path;
+    if (access(path.c_str(), R_OK) != 0) {
+      throw fire::Exception(
+          "FileDNE", "Vertex library '" + path + "' can't be read.", false);
+    }
+    return;
+  }
+
+  // Assumptions:
+  //  - Directory passed is a flat directory (no sub directories) containing LHE
+  //  files
+  //  - LHE files are events generated with the correct mass point
+  DIR *dir;           // handle to opened directory
+  struct dirent *ent; // handle to entry inside directory
+  if ((dir = opendir(path.c_str())) != NULL) {
+    // directory can be opened
+    while ((ent = readdir(dir)) != NULL) {
+      std::string fp = path + '/' + std::string(ent->d_name);
+      if (hasExtension(fp, ".dblib"))
+        binary_file_ = fp;
+      else if (hasExtension(fp, ".lhe"))
+        lhe_files_.push_back(fp);
+    }
+    closedir(dir);
+  }
+
+  if (!binary_file_.empty()) {
+    lhe_files_.clear();
+  } else if (lhe_files_.empty()) {
+    throw fire::Exception("DirDNE",
+                          "Directory '" + path +
+                              "' was unable to be opened or no '.lhe' "
+                              "or '.dblib' files were found inside of it.",
+                          false);
+  }
+
+  // the order of readdir is arbitrary, parse in a reproducible order
+  std::sort(lhe_files_.begin(), lhe_files_.end());
+}
+
+VertexLibrary::~VertexLibrary() {
+  if (mapping_) munmap(mapping_, mapping_size_);
+}
+
+void VertexLibrary::doLoad() {
+  if (!index_file_.empty()) readIndex();
+  if (!binary_file_.empty())
+    mapBinary();
+  else
+    parseLHEFiles();
+  loaded_ = true;
+}
+
+void VertexLibrary::readIndex() {
+  std::ifstream index(index_file_);
+  if (!index) {
+    throw fire::Exception(
+        "FileDNE", "Vertex library index '" + index_file_ + "' can't be read.",
+        false);
+  }
+
+  // files in the index are relative to its directory
+  std::string dir{index_file_.substr(0, index_file_.find_last_of('/') + 1)};
+
+  std::set<double> masses;
+  std::string line;
+  while (std::getline(index, line)) {
+    if (line.empty() or line[0] == '#') continue;
+    std::istringstream iss(line);
+    double mass;
+    Bin bin;
+    std::string file;
+    if (!(iss >> mass >> bin.energy >> file >> bin.offset >> bin.count)) {
+      throw fire::Exception("BadIndex",
+                            "Malformed line in vertex library index '" +
+                                index_file_ + "': '" + line + "'.",
+                            false);
+    }
+    masses.insert(mass);
+    if (std::abs(1. - mass / aprime_mass_) > 1e-3) continue;
+    if (binary_file_.empty()) binary_file_ = dir + file;
+    if (binary_file_ != dir + file) {
+      throw fire::Exception("BadIndex",
+                            "The vertices for A' mass " +
+                                std::to_string(aprime_mass_) +
+                                "GeV are split across several libraries in '" +
+                                index_file_ + "'. Merge them into one.",
+                            false);
+    }
+    owned_bins_.push_back(bin);
+  }
+
+  if (owned_bins_.empty()) {
+    std::string available;
+    for (double mass : masses) available += " " + std::to_string(mass);
+    throw fire::Exception("NoMass",
+                          "No vertex library for A' mass " +
+                              std::to_string(aprime_mass_) + "GeV in '" +
+                              index_file_ + "'. Available masses [GeV]:" +
+                              available,
+                          false);
+  }
+
+  // the bins must be sorted by energy for sampling
+  std::sort(owned_bins_.begin(), owned_bins_.end(),
+            [](const Bin &l, const Bin &r) { return l.energy < r.energy; });
+}
+
+void VertexLibrary::mapBinary() {
+  int fd = open(binary_file_.c_str(), O_RDONLY);
+  struct stat info;
+  if (fd < 0 or fstat(fd, &info) != 0 or
+      std::size_t(info.st_size) < sizeof(FileHeader)) {
+    if (fd >= 0) close(fd);
+    throw fire::Exception("BadLibrary",
+                          "Vertex library '" + binary_file_ +
+                              "' can't be opened or is too short.",
+                          false);
+  }
+
+  mapping_size_ = info.st_size;
+  void *mapping = mmap(nullptr, mapping_size_, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    mapping_size_ = 0;
+    throw fire::Exception("BadLibrary",
+                          "Unable to map vertex library '" + binary_file_ +
+                              "' into memory.",
+                          false);
+  }
+  mapping_ = mapping;
+
+  const auto &header{*static_cast<const FileHeader *>(mapping_)};
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 or
+      header.version != VERSION) {
+    throw fire::Exception("BadLibrary",
+                          "'" + binary_file_ +
+                              "' is not a vertex library of version " +
+                              std::to_string(VERSION) + ".",
+                          false);
+  }
+
+  std::size_t expected_size{sizeof(FileHeader) +
+                            header.num_bins * sizeof(Bin) +
+                            header.num_vertices * sizeof(Vertex)};
+  if (mapping_size_ != expected_size) {
+    throw fire::Exception("BadLibrary",
+                          "The size of vertex library '" + binary_file_ +
+                              "' does not match its contents.",
+                          false);
+  }
+
+  if (std::abs(1. - header.aprime_mass / aprime_mass_) > 1e-3) {
+    throw fire::Exception("BadMGEvnt",
+                          "The vertex library has a different "
+                          "APrime mass than the model has (Library = " +
+                              std::to_string(header.aprime_mass) +
+                              "GeV; Model = " + std::to_string(aprime_mass_) +
+                              "GeV).",
+                          false);
+  }
+
+  auto data{static_cast<const char *>(mapping_) + sizeof(FileHeader)};
+  vertices_ = reinterpret_cast<const Vertex *>(data +
+                                               header.num_bins * sizeof(Bin));
+  if (owned_bins_.empty()) {
+    bins_ = reinterpret_cast<const Bin *>(data);
+    num_bins_ = header.num_bins;
+    return;
+  }
+
+  // the bins come from the index, make sure it is not stale
+  for (const auto &bin : owned_bins_) {
+    if (bin.offset + bin.count > header.num_vertices) {
+      throw fire::Exception("BadIndex",
+                            "The index '" + index_file_ +
+                                "' does not match the vertex library '" +
+                                binary_file_ + "'. Re-index the store.",
+                            false);
+    }
+  }
+  bins_ = owned_bins_.data();
+  num_bins_ = owned_bins_.size();
+}
+
+void VertexLibrary::parseLHEFiles() {
+  VertexMap vertices;
+  double aprime_mass{aprime_mass_};
+  for (const auto &file_name : lhe_files_)
+    parseLHE(file_name, aprime_mass, vertices);
+
+  for (auto &[energy, bin_vertices] : vertices) {
+    owned_bins_.push_back({energy, owned_vertices_.size(), bin_vertices.size()});
+    owned_vertices_.insert(owned_vertices_.end(), bin_vertices.begin(),
+                           bin_vertices.end());
+  }
+
+  bins_ = owned_bins_.data();
+  num_bins_ = owned_bins_.size();
+  vertices_ = owned_vertices_.data();
+}
+
+void VertexLibrary::parseLHE(const std::string &file_name,
+                             double &aprime_mass, VertexMap &vertices) {
+  std::ifstream ifile;
+  ifile.open(file_name.c_str());
+  if (!ifile) {
+    throw fire::Exception("LHEFile",
+                          "Unable to open LHE file '" + file_name + "'.",
+                          false);
+  }
+
+  std::string line;
+  while (std::getline(ifile, line)) {
+    std::istringstream iss(line);
+    int ptype, state;
+    double skip, px, py, pz, E, M;
+    if (iss >> ptype >> state >> skip >> skip >> skip >> skip >> px >> py >>
+        pz >> E >> M) {
+      if ((ptype == 11) && (state == -1)) {
+        double ebeam = E;
+        double e_px, e_py, e_pz, a_px, a_py, a_pz, e_E, a_E, e_M, a_M;
+        for (int i = 0; i < 2; i++) {
+          std::getline(ifile, line);
+        }
+        std::istringstream jss(line);
+        jss >> ptype >> state >> skip >> skip >> skip >> skip >> e_px >> e_py >>
+            e_pz >> e_E >> e_M;
+        if ((ptype == 11) && (state == 1)) { // Find a final state electron.
+          for (int i = 0; i < 2; i++) {
+            std::getline(ifile, line);
+          }
+          std::istringstream kss(line);
+          kss >> ptype >> state >> skip >> skip >> skip >> skip >> a_px >>
+              a_py >> a_pz >> a_E >> a_M;
+          if (ptype == 622 and state == 1) {
+            if (aprime_mass <= 0.) aprime_mass = a_M;
+            if (std::abs(1. - a_M / aprime_mass) > 1e-3) {
+              throw fire::Exception(
+                  "BadMGEvnt",
+                  "A MadGraph imported event has a different "
+                  "APrime mass than the model has (MadGraph = " +
+                      std::to_string(a_M) + "GeV; Model = " +
+                      std::to_string(aprime_mass) + "GeV).",
+                  false);
+            }
+            Vertex vertex{{float(e_px), float(e_py), float(e_pz), float(e_E)},
+                          {float(a_px + e_px), float(a_py + e_py),
+                           float(a_pz + e_pz), float(a_E + e_E)}};
+            vertices[ebeam].push_back(vertex);
+          } // get a prime kinematics
+        }   // check for final state
+      }     // check for particle type and state
+    }       // able to get momentum/energy numbers
+  }         // while getting lines
+  ifile.close();
+}
+
+void VertexLibrary::write(const std::string &file_name, double aprime_mass,
+                          const VertexMap &vertices) {
+  FileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.num_bins = vertices.size();
+  header.aprime_mass = aprime_mass;
+
+  std::vector<Bin> bins;
+  for (const auto &[energy, bin_vertices] : vertices) {
+    bins.push_back({energy, header.num_vertices, bin_vertices.size()});
+    header.num_vertices += bin_vertices.size();
+  }
+
+  std::ofstream file(file_name, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char *>(bins.data()),
+             bins.size() * sizeof(Bin));
+  for (const auto &[energy, bin_vertices] : vertices) {
+    file.write(reinterpret_cast<const char *>(bin_vertices.data()),
+               bin_vertices.size() * sizeof(Vertex));
+  }
+  if (!file.good()) {
+    throw fire::Exception(
+        "FileWrite", "Unable to write vertex library '" + file_name + "'.",
+        false);
+  }
+}
+
+std::size_t VertexLibrary::writeIndex(const std::string &dir) {
+  std::vector<std::string> libraries;
+  DIR *d = opendir(dir.c_str());
+  if (d == NULL) {
+    throw fire::Exception(
+        "DirDNE", "Directory '" + dir + "' was unable to be opened.", false);
+  }
+  struct dirent *ent;
+  while ((ent = readdir(d)) != NULL) {
+    std::string name{ent->d_name};
+    if (hasExtension(name, ".dblib")) libraries.push_back(name);
+  }
+  closedir(d);
+  std::sort(libraries.begin(), libraries.end());
+
+  std::string index_name{dir + '/' + INDEX_NAME};
+  std::ofstream index(index_name, std::ios::trunc);
+  index << "# mass [GeV] energy [GeV] file offset count\n"
+        << std::setprecision(std::numeric_limits<double>::digits10 + 1);
+  for (const auto &library : libraries) {
+    FileHeader header;
+    std::vector<Bin> bins;
+    if (!readBins(dir + '/' + library, header, bins)) {
+      throw fire::Exception("BadLibrary",
+                            "'" + library +
+                                "' is not a vertex library of version " +
+                                std::to_string(VERSION) + ".",
+                            false);
+    }
+    for (const auto &bin : bins) {
+      index << header.aprime_mass << " " << bin.energy << " " << library
+            << " " << bin.offset << " " << bin.count << "\n";
+    }
+  }
+  if (!index.good()) {
+    throw fire::Exception(
+        "FileWrite",
+        "Unable to write vertex library index '" + index_name + "'.", false);
+  }
+  return libraries.size();
+}
+
+}  // namespace darkbrem
+}  // namespace g4fire
@@ -0,0 +1,112 @@
+#include "g4fire/DarkBrem/WeizsackerWilliams.h"
+
+#include <math.h>
+
+#include <cmath>
+
+#include "G4Electron.hh"
+#include "G4SystemOfUnits.hh"
+
+#include "g4fire/DarkBrem/GaussKronrod.h"
+
+namespace g4fire {
+namespace darkbrem {
+namespace ww {
+
+Chi::Chi(double A, double Z, double E0, double MA, double Mel)
+    : Z{Z} {
+  G4double MUp = 2.79;  // mass up quark [GeV]
+  G4double Mpr = 0.938; // mass proton [GeV]
+
+  G4double ap = 773.0 / (Mel * pow(Z, 2. / 3.));
+  G4double a = 111.0 / (Mel * pow(Z, 1. / 3.));
+  a2 = a * a;
+  ap2 = ap * ap;
+  d_inv = pow(A, 2. / 3.) / 0.164;
+  up = (MUp * MUp - 1.0) / (4.0 * Mpr * Mpr);
+  tmin = MA * MA * MA * MA / 4.0 / E0 / E0;
+}
+
+double Chi::operator()(double t) const {
+  // G2el = Z^2 a^4 t^2 / ((1 + a^2 t)^2 (1 + t/d)^2)
+  G4double el = a2 * t / ((1.0 + a2 * t) * (1.0 + t * d_inv));
+  // G2in = Z ap^4 t^2 / ((1 + ap^2 t)^2 (1 + t/0.71)^8) (1 + t up)^2
+  G4double in = ap2 * t / (1.0 + ap2 * t);
+  G4double dipole = 1.0 + t / 0.71;
+  dipole *= dipole;
+  dipole *= dipole;
+  G4double in_up = 1.0 + t * up;
+  G4double G2 =
+      Z * Z * el * el + Z * in * in * in_up * in_up / (dipole * dipole);
+  G4double Under = G2 * (t - tmin) / t / t;
+
+  return Under;
+}
+
+double DiffCross::operator()(double x) const {
+  G4double beta = sqrt(1 - MA * MA / E0 / E0);
+  G4double num = 1. - x + x * x / 3.;
+  G4double denom = MA * MA * (1. - x) / x + Mel * Mel * x;
+
+  return beta * num / denom;
+}
+
+G4double CrossSectionPerAtom(double E0, double A, double Z, double MA,
+                             double epsilon) {
+  static const double Mel =
+      G4Electron::Electron()->GetPDGMass() / CLHEP::GeV; // mass electron in GeV
+
+  if (E0 <= MA)
+    return 0.; // can't produce a prime
+
+  // begin: chi-formfactor calculation
+  Chi chiformfactor(A, Z, E0, MA, Mel);
+
+  double tmin = MA * MA * MA * MA / (4. * E0 * E0);
+  double tmax = MA * MA;
+
+  // Integrate over chi in u = ln(t), dt = t du
+  G4double ChiRes = gausskronrod::integrate(
+      [&chiformfactor](double u) {
+        double t = std::exp(u);
+        return chiformfactor(t) * t;
+      },
+      std::log(tmin), std::log(tmax));
+
+  // Integrate over x. Can use log approximation instead, which falls off at
+  // high A' mass.
+  DiffCross diffcross;
+  diffcross.E0 = E0;
+  diffcross.MA = MA;
+  diffcross.Mel = Mel;
+
+  double xmax = 1;
+  if ((Mel / E0) > (MA / E0))
+    xmax = 1 - Mel / E0;
+  else
+    xmax = 1 - MA / E0;
+
+  // Integrate over differential cross section in y = -ln(1-x),
+  // dx = exp(-y) dy
+  G4double DsDx = gausskronrod::integrate(
+      [&diffcross](double y) {
+        double one_minus_x = std::exp(-y);
+        return diffcross(1. - one_minus_x) * one_minus_x;
+      },
+      0., -std::log1p(-xmax));
+
+  G4double GeVtoPb = 3.894E08;
+  G4double alphaEW = 1.0 / 137.0;
+
+  G4double cross = GeVtoPb * 4. * alphaEW * alphaEW * alphaEW * epsilon *
+                   epsilon * ChiRes * DsDx * CLHEP::picobarn;
+
+  if (cross < 0.)
+    return 0.; // safety check all the math
+
+  return cross;
+}
+
+}  // namespace ww
+}  // namespace darkbrem
+}  // namespace g4fire
@@ -0,0 +1,229 @@
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//------------//
+//   g4fire   //
+//------------//
+#include "g4fire/DarkBrem/VertexLibrary.h"
+
+using g4fire::darkbrem::VertexLibrary;
+namespace fs = std::filesystem;
+
+/**
+ * @func printUsage
+ *
+ * Print how to use this executable to the terminal.
+ */
+void printUsage();
+
+/**
+ * @func unpack
+ *
+ * Unpack a tar.gz archive by running tar directly, without a shell, so
+ * that the file names are never interpreted.
+ *
+ * @param[in] archive path to the tar.gz archive
+ * @param[in] dir directory to unpack the archive into
+ * @return true if tar succeeded
+ */
+bool unpack(const std::string& archive, const std::string& dir);
+
+/**
+ * @func findLHEFiles
+ *
+ * Collect the LHE files of an input, unpacking it first if it is an archive.
+ *
+ * @param[in] input LHE file, directory of LHE files or tar.gz archive
+ * @param[in,out] lhe_files list of LHE files to add to
+ * @param[in,out] unpacked temporary directories the archives were unpacked to
+ * @return false if the input could not be read
+ */
+bool findLHEFiles(const std::string& input, std::vector<std::string>& lhe_files,
+                  std::vector<std::string>& unpacked);
+
+/**
+ * The executable main for converting LHE vertex libraries to binary ones.
+ */
+int main(int argc, char* argv[]) {
+  unsigned int n_threads{std::max(1u, std::thread::hardware_concurrency())};
+  std::vector<std::string> args;
+  for (int i_arg = 1; i_arg < argc; i_arg++) {
+    std::string arg{argv[i_arg]};
+    if (arg == "-h" or arg == "--help") {
+      printUsage();
+      return 0;
+    } else if (arg == "-j" and i_arg + 1 < argc) {
+      n_threads = std::max(1, atoi(argv[++i_arg]));
+    } else if (arg == "--index" and i_arg + 1 < argc) {
+      std::string store{argv[++i_arg]};
+      try {
+        auto n_libraries{VertexLibrary::writeIndex(store)};
+        std::cout << "Indexed " << n_libraries << " vertex libraries in '"
+                  << store << "'." << std::endl;
+      } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 6;
+      }
+      return 0;
+    } else {
+      args.push_back(arg);
+    }
+  }
+
+  if (args.size() < 2) {
+    printUsage();
+    return 1;
+  }
+
+  std::string output{args.front()};
+  std::vector<std::string> lhe_files, unpacked;
+  for (auto input{args.begin() + 1}; input != args.end(); ++input) {
+    if (!findLHEFiles(*input, lhe_files, unpacked)) {
+      std::cerr << "Unable to read '" << *input << "'." << std::endl;
+      return 2;
+    }
+  }
+  // the vertices within a bin are in the order of the files
+  std::sort(lhe_files.begin(), lhe_files.end());
+
+  std::cout << "Parsing " << lhe_files.size() << " LHE files with "
+            << n_threads << " threads..." << std::endl;
+
+  // each file is parsed into its own map, they are merged in order afterwards
+  // so that the output does not depend on the scheduling of the threads
+  std::vector<VertexLibrary::VertexMap> parsed(lhe_files.size());
+  std::vector<double> masses(lhe_files.size(), 0.);
+  std::atomic<std::size_t> next_file{0};
+  std::mutex error_mutex;
+  std::string error;
+  std::vector<std::thread> workers;
+  for (unsigned int i_thread = 0; i_thread < n_threads; i_thread++) {
+    workers.emplace_back([&]() {
+      for (std::size_t i_file = next_file++; i_file < lhe_files.size();
+           i_file = next_file++) {
+        try {
+          VertexLibrary::parseLHE(lhe_files[i_file], masses[i_file],
+                                  parsed[i_file]);
+        } catch (const std::exception& e) {
+          std::lock_guard<std::mutex> lock(error_mutex);
+          error = "Unable to parse '" + lhe_files[i_file] + "': " + e.what();
+        }
+      }
+    });
+  }
+  for (auto& worker : workers) worker.join();
+
+  for (const auto& dir : unpacked) fs::remove_all(dir);
+
+  if (!error.empty()) {
+    std::cerr << error << std::endl;
+    return 3;
+  }
+
+  double aprime_mass{0.};
+  VertexLibrary::VertexMap vertices;
+  for (std::size_t i_file = 0; i_file < lhe_files.size(); i_file++) {
+    if (parsed[i_file].empty()) continue;
+    if (aprime_mass <= 0.) aprime_mass = masses[i_file];
+    if (std::abs(1. - masses[i_file] / aprime_mass) > 1e-3) {
+      std::cerr << "'" << lhe_files[i_file] << "' has a different A' mass ("
+                << masses[i_file] << " GeV) than the other files ("
+                << aprime_mass << " GeV)." << std::endl;
+      return 4;
+    }
+    for (auto& [energy, bin_vertices] : parsed[i_file]) {
+      auto& bin{vertices[energy]};
+      bin.insert(bin.end(), bin_vertices.begin(), bin_vertices.end());
+    }
+  }
+
+  if (vertices.empty()) {
+    std::cerr << "No dark brem vertices found." << std::endl;
+    return 5;
+  }
+
+  try {
+    VertexLibrary::write(output, aprime_mass, vertices);
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 6;
+  }
+
+  std::cout << "Wrote " << vertices.size() << " energy bins for A' mass "
+            << aprime_mass << " GeV to '" << output << "'." << std::endl;
+  return 0;
+}
+
+bool findLHEFiles(const std::string& input, std::vector<std::string>& lhe_files,
+                  std::vector<std::string>& unpacked) {
+  std::error_code ec;
+  fs::path path{input};
+  if (input.size() > 7 and input.substr(input.size() - 7) == ".tar.gz") {
+    char dir_template[] = "/tmp/dblib-XXXXXX";
+    if (!mkdtemp(dir_template)) return false;
+    unpacked.push_back(dir_template);
+    if (!unpack(input, dir_template)) return false;
+    path = dir_template;
+  }
+
+  if (fs::is_regular_file(path, ec)) {
+    lhe_files.push_back(path.string());
+    return true;
+  }
+
+  if (!fs::is_directory(path, ec)) return false;
+  for (const auto& entry : fs::recursive_directory_iterator(path, ec)) {
+    if (entry.is_regular_file() and entry.path().extension() == ".lhe")
+      lhe_files.push_back(entry.path().string());
+  }
+  return !ec;
+}
+
+bool unpack(const std::string& archive, const std::string& dir) {
+  pid_t pid = fork();
+  if (pid < 0) return false;
+  if (pid == 0) {
+    execlp("tar", "tar", "-xzf", archive.c_str(), "-C", dir.c_str(),
+           static_cast<char*>(nullptr));
+    _exit(127);
+  }
+  int status;
+  while (waitpid(pid, &status, 0) < 0) {
+    if (errno != EINTR) return false;
+  }
+  return WIFEXITED(status) and WEXITSTATUS(status) == 0;
+}
+
+void printUsage() {
+  std::cout << "Usage: convert-vertex-library [-j N] {library.dblib} "
+               "{input} [{input} ...]"
+            << std::endl;
+  std::cout << "       convert-vertex-library --index {store}" << std::endl;
+  std::cout << "     library.dblib  (required) binary vertex library to write"
+            << std::endl;
+  std::cout << "     input          (required) LHE file, directory of LHE "
+               "files or tar.gz archive of them"
+            << std::endl;
+  std::cout << "     -j N           number of files to parse in parallel, "
+               "defaults to the number of cores"
+            << std::endl;
+  std::cout << "     --index store  write the index of the libraries in the "
+               "directory store, one library per A' mass"
+            << std::endl;
+}
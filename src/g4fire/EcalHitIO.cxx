@@ -58,6 +58,7 @@ void EcalHitIO::writeHitsCollection(
     float edep = g4hit->getEdep();
     float time = g4hit->getTime();
     int pdgCode = g4hit->getPdgCode();
+    float weight = g4hit->getWeight();
 
     // Is hit contrib output enabled?
     if (enableHitContribs_) {
@@ -65,10 +66,13 @@ void EcalHitIO::writeHitsCollection(
       int trackID = g4hit->getTrackID();
 
       // Find if there is an existing hit contrib.
-      int contribIndex = hitMap[hitID].findContribIndex(trackID, pdgCode);
+      int contribIndex =
+          hitMap[hitID].findContribIndex(trackID, pdgCode, weight);
 
       // Is contrib output being compressed and a record exists for this
-      // SimParticle and PDG code?
+      // SimParticle, PDG code and weight? Biasing can change the weight of
+      // a track along the way, steps with another weight get their own
+      // record.
       if (compressHitContribs_ && contribIndex != -1) {
         // Update an existing hit contrib.
         hitMap[hitID].updateContrib(contribIndex, edep, time);
@@ -77,13 +81,14 @@ void EcalHitIO::writeHitsCollection(
         // Add a hit contrib because all steps are being saved or there is not
         // an existing record.
         hitMap[hitID].addContrib(trackMap->findIncident(trackID), trackID,
-                                 pdgCode, edep, time);
+                                 pdgCode, edep, time, weight);
       }
 
     } else {
       // Hit contributions are not being saved so manually increment the edep
-      // and set time.
-      hitMap[hitID].setEdep(hitMap[hitID].getEdep() + edep);
+      // and set time. Without contributions the track weights would be
+      // lost, so the edep is weighted here.
+      hitMap[hitID].setEdep(hitMap[hitID].getEdep() + edep * weight);
       if (time < hitMap[hitID].getTime() || hitMap[hitID].getTime() == 0) {
         hitMap[hitID].setTime(time);
       }
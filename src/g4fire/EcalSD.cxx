@@ -8,6 +8,8 @@
 #include "G4StepPoint.hh"
 #include "G4VSolid.hh"
 
+#include "g4fire/UserTrackInformation.h"
+
 /*~~~~~~~~~~~~~~*/
 /*   DetDescr   */
 /*~~~~~~~~~~~~~~*/
@@ -46,6 +48,9 @@ G4bool EcalSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
     return false;
   }
 
+  // Skip steps that happen outside of the readout window.
+  if (!isInReadoutWindow(aStep)) return false;
+
   // Create a new cal hit.
   G4CalorimeterHit* hit = new G4CalorimeterHit();
 
@@ -80,6 +85,9 @@ G4bool EcalSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
   // Set the PDG code from the track.
   hit->setPdgCode(aStep->GetTrack()->GetParticleDefinition()->GetPDGEncoding());
 
+  // Set the weight of the track, it differs from one when biasing splits it.
+  hit->setWeight(UserTrackInformation::getHitWeight(aStep->GetTrack()));
+
   if (this->verboseLevel > 2) {
     G4cout << "Created new SimCalorimeterHit in detector " << this->GetName()
            << " with subdet ID " << id << " ...";
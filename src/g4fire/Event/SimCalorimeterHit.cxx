@@ -16,6 +16,7 @@ ClassImp(ldmx::SimCalorimeterHit)
     pdgCodeContribs_.clear();
     edepContribs_.clear();
     timeContribs_.clear();
+    weightContribs_.clear();
 
     nContribs_ = 0;
     id_ = 0;
@@ -36,12 +37,13 @@ ClassImp(ldmx::SimCalorimeterHit)
   }
 
   void SimCalorimeterHit::addContrib(int incidentID, int trackID, int pdgCode,
-                                     float edep, float time) {
+                                     float edep, float time, float weight) {
     incidentIDContribs_.push_back(incidentID);
     trackIDContribs_.push_back(trackID);
     pdgCodeContribs_.push_back(pdgCode);
     edepContribs_.push_back(edep);
     timeContribs_.push_back(time);
+    weightContribs_.push_back(weight);
     edep_ += edep;
     if (time < time_ || time_ == 0) {
       time_ = time;
@@ -56,14 +58,20 @@ ClassImp(ldmx::SimCalorimeterHit)
     contrib.edep = edepContribs_.at(i);
     contrib.time = timeContribs_.at(i);
     contrib.pdgCode = pdgCodeContribs_.at(i);
+    // hits written before the weights were stored have none
+    contrib.weight = static_cast<std::size_t>(i) < weightContribs_.size()
+                         ? weightContribs_[i]
+                         : 1.;
     return contrib;
   }
 
-  int SimCalorimeterHit::findContribIndex(int trackID, int pdgCode) const {
+  int SimCalorimeterHit::findContribIndex(int trackID, int pdgCode,
+                                          float weight) const {
     int contribIndex = -1;
     for (int iContrib = 0; iContrib < nContribs_; iContrib++) {
       Contrib contrib = getContrib(iContrib);
-      if (contrib.trackID == trackID && contrib.pdgCode == pdgCode) {
+      if (contrib.trackID == trackID && contrib.pdgCode == pdgCode &&
+          contrib.weight == weight) {
         contribIndex = iContrib;
         break;
       }
@@ -0,0 +1,243 @@
+#include "g4fire/Event/SimHitColumns.h"
+
+// STL
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+ClassImp(ldmx::SimTrackerHitColumns)
+ClassImp(ldmx::SimCalorimeterHitColumns)
+templateClassImp(ldmx::QuantizedSimTrackerHitColumns)
+templateClassImp(ldmx::QuantizedSimCalorimeterHitColumns)
+
+    namespace ldmx {
+  void SimTrackerHitColumns::Clear() {
+    id_.clear();
+    layerID_.clear();
+    moduleID_.clear();
+    edep_.clear();
+    time_.clear();
+    px_.clear();
+    py_.clear();
+    pz_.clear();
+    energy_.clear();
+    x_.clear();
+    y_.clear();
+    z_.clear();
+    pathLength_.clear();
+    trackID_.clear();
+    pdgID_.clear();
+    weight_.clear();
+  }
+
+  void SimTrackerHitColumns::Print() const {
+    std::cout << "SimTrackerHitColumns { "
+              << "num hits: " << size() << " }" << std::endl;
+  }
+
+  void SimTrackerHitColumns::reserve(std::size_t n) {
+    id_.reserve(n);
+    layerID_.reserve(n);
+    moduleID_.reserve(n);
+    edep_.reserve(n);
+    time_.reserve(n);
+    px_.reserve(n);
+    py_.reserve(n);
+    pz_.reserve(n);
+    energy_.reserve(n);
+    x_.reserve(n);
+    y_.reserve(n);
+    z_.reserve(n);
+    pathLength_.reserve(n);
+    trackID_.reserve(n);
+    pdgID_.reserve(n);
+    weight_.reserve(n);
+  }
+
+  void SimTrackerHitColumns::append(const SimTrackerHit &hit) {
+    auto position{hit.getPosition()};
+    auto momentum{hit.getMomentum()};
+    id_.push_back(hit.getID());
+    layerID_.push_back(hit.getLayerID());
+    moduleID_.push_back(hit.getModuleID());
+    edep_.push_back(hit.getEdep());
+    time_.push_back(hit.getTime());
+    px_.push_back(momentum[0]);
+    py_.push_back(momentum[1]);
+    pz_.push_back(momentum[2]);
+    energy_.push_back(hit.getEnergy());
+    x_.push_back(position[0]);
+    y_.push_back(position[1]);
+    z_.push_back(position[2]);
+    pathLength_.push_back(hit.getPathLength());
+    trackID_.push_back(hit.getTrackID());
+    pdgID_.push_back(hit.getPdgID());
+    weight_.push_back(hit.getWeight());
+  }
+
+  void SimTrackerHitColumns::fill(const std::vector<SimTrackerHit> &hits) {
+    Clear();
+    reserve(hits.size());
+    for (const auto &hit : hits) append(hit);
+  }
+
+  SimTrackerHit SimTrackerHitColumns::getHit(std::size_t i) const {
+    SimTrackerHit hit;
+    hit.setID(id_.at(i));
+    hit.setLayerID(layerID_.at(i));
+    hit.setModuleID(moduleID_.at(i));
+    hit.setEdep(edep_.at(i));
+    hit.setTime(time_.at(i));
+    hit.setMomentum(px_.at(i), py_.at(i), pz_.at(i));
+    hit.setEnergy(energy_.at(i));
+    hit.setPosition(x_.at(i), y_.at(i), z_.at(i));
+    hit.setPathLength(pathLength_.at(i));
+    hit.setTrackID(trackID_.at(i));
+    hit.setPdgID(pdgID_.at(i));
+    hit.setWeight(weight_.at(i));
+    return hit;
+  }
+
+  void SimCalorimeterHitColumns::Clear() {
+    id_.clear();
+    edep_.clear();
+    x_.clear();
+    y_.clear();
+    z_.clear();
+    time_.clear();
+    contribOffsets_.assign(1, 0);
+    incidentIDContribs_.clear();
+    trackIDContribs_.clear();
+    pdgCodeContribs_.clear();
+    edepContribs_.clear();
+    timeContribs_.clear();
+    weightContribs_.clear();
+  }
+
+  void SimCalorimeterHitColumns::Print() const {
+    std::cout << "SimCalorimeterHitColumns { "
+              << "num hits: " << size()
+              << ", num contribs: " << getNumberOfContribs() << " }"
+              << std::endl;
+  }
+
+  void SimCalorimeterHitColumns::append(const SimCalorimeterHit &hit) {
+    auto position{hit.getPosition()};
+    id_.push_back(hit.getID());
+    edep_.push_back(hit.getEdep());
+    x_.push_back(position[0]);
+    y_.push_back(position[1]);
+    z_.push_back(position[2]);
+    time_.push_back(hit.getTime());
+
+    for (unsigned iContrib = 0; iContrib < hit.getNumberOfContribs();
+         iContrib++) {
+      SimCalorimeterHit::Contrib contrib = hit.getContrib(iContrib);
+      incidentIDContribs_.push_back(contrib.incidentID);
+      trackIDContribs_.push_back(contrib.trackID);
+      pdgCodeContribs_.push_back(contrib.pdgCode);
+      edepContribs_.push_back(contrib.edep);
+      timeContribs_.push_back(contrib.time);
+      weightContribs_.push_back(contrib.weight);
+    }
+    contribOffsets_.push_back(edepContribs_.size());
+  }
+
+  void SimCalorimeterHitColumns::fill(
+      const std::vector<SimCalorimeterHit> &hits) {
+    Clear();
+    id_.reserve(hits.size());
+    edep_.reserve(hits.size());
+    x_.reserve(hits.size());
+    y_.reserve(hits.size());
+    z_.reserve(hits.size());
+    time_.reserve(hits.size());
+    contribOffsets_.reserve(hits.size() + 1);
+    for (const auto &hit : hits) append(hit);
+  }
+
+  SimCalorimeterHit SimCalorimeterHitColumns::getHit(std::size_t i) const {
+    SimCalorimeterHit hit;
+    hit.setID(id_.at(i));
+    hit.setPosition(x_.at(i), y_.at(i), z_.at(i));
+    for (unsigned iContrib = contribOffsets_.at(i);
+         iContrib < contribOffsets_.at(i + 1); iContrib++) {
+      hit.addContrib(incidentIDContribs_[iContrib], trackIDContribs_[iContrib],
+                     pdgCodeContribs_[iContrib], edepContribs_[iContrib],
+                     timeContribs_[iContrib], weightContribs_[iContrib]);
+    }
+    // the hit totals are not necessarily the sum of the contributions
+    // (e.g. when contributions are disabled), so restore them directly
+    hit.setEdep(edep_.at(i));
+    hit.setTime(time_.at(i));
+    return hit;
+  }
+
+  namespace quantization {
+
+  std::int32_t toFixed(float value, double step) {
+    if (step <= 0.) {
+      std::int32_t bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      return bits;
+    }
+    if (std::isnan(value)) return 0;
+    double multiple{std::round(value / step)};
+    if (multiple >= std::numeric_limits<std::int32_t>::max())
+      return std::numeric_limits<std::int32_t>::max();
+    if (multiple <= std::numeric_limits<std::int32_t>::min())
+      return std::numeric_limits<std::int32_t>::min();
+    return static_cast<std::int32_t>(multiple);
+  }
+
+  float fromFixed(std::int32_t code, double step) {
+    if (step <= 0.) {
+      float value;
+      std::memcpy(&value, &code, sizeof(value));
+      return value;
+    }
+    return code * step;
+  }
+
+  std::uint16_t toHalf(float value) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    std::uint16_t sign = (bits >> 16) & 0x8000;
+    std::uint32_t magnitude = bits & 0x7fffffff;
+    // infinity and NaN (keeping it quiet)
+    if (magnitude >= 0x7f800000)
+      return sign | 0x7c00 | (magnitude > 0x7f800000 ? 0x200 : 0);
+    // at least half way past the largest half, saturate to it
+    if (magnitude >= 0x477ff000) return sign | 0x7bff;
+    // below the smallest normal half, count multiples of 2^-24
+    if (magnitude < 0x38800000) {
+      float subnormal;
+      std::memcpy(&subnormal, &magnitude, sizeof(subnormal));
+      return sign |
+             static_cast<std::uint16_t>(std::nearbyint(subnormal * 0x1p24f));
+    }
+    // re-bias the exponent and round the mantissa to nearest-even,
+    // a carry out of the mantissa correctly bumps the exponent
+    magnitude += 0xfff + ((magnitude >> 13) & 1);
+    return sign | static_cast<std::uint16_t>((magnitude - 0x38000000) >> 13);
+  }
+
+  float fromHalf(std::uint16_t code) {
+    std::uint32_t exponent = (code >> 10) & 0x1f;
+    std::uint32_t mantissa = code & 0x3ff;
+    float value;
+    if (exponent == 0) {
+      value = std::ldexp(static_cast<float>(mantissa), -24);
+    } else if (exponent == 0x1f) {
+      value = mantissa ? std::numeric_limits<float>::quiet_NaN()
+                       : std::numeric_limits<float>::infinity();
+    } else {
+      std::uint32_t bits = ((exponent + 112) << 23) | (mantissa << 13);
+      std::memcpy(&value, &bits, sizeof(value));
+    }
+    return (code & 0x8000) ? -value : value;
+  }
+
+  }  // namespace quantization
+}  // namespace ldmx
@@ -15,7 +15,8 @@ ClassImp(ldmx::SimTrackerHit)
               << "position: ( " << x_ << ", " << y_ << ", " << z_ << " ), "
               << "edep: " << edep_ << ", "
               << "time: " << time_ << ", "
-              << "momentum: ( " << px_ << ", " << py_ << ", " << pz_ << " )"
+              << "momentum: ( " << px_ << ", " << py_ << ", " << pz_ << " ), "
+              << "weight: " << weight_
               << " }" << std::endl;
   }
 
@@ -35,6 +36,7 @@ ClassImp(ldmx::SimTrackerHit)
     pathLength_ = 0;
     trackID_ = -1;
     pdgID_ = 0;
+    weight_ = 1.;
   }
 
   void SimTrackerHit::setPosition(const float x, const float y, const float z) {
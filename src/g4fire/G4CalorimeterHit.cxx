@@ -32,7 +32,8 @@ std::ostream& G4CalorimeterHit::print(std::ostream& os) {
   os << "G4CalorimeterHit { "
      << "edep: " << this->edep_ << ", "
      << "position: " << position_ << ", "
-     << "time: " << this->time_ << " }" << std::endl;
+     << "time: " << this->time_ << ", "
+     << "weight: " << this->weight_ << " }" << std::endl;
   return os;
 }
 
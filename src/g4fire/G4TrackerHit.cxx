@@ -40,7 +40,8 @@ std::ostream& G4TrackerHit::print(std::ostream& os) {
      << "momentum: (" << this->momentum_[0] << ", " << this->momentum_[1]
      << ", " << this->momentum_[2] << "), "
      << "pathLength: " << this->pathLength_ << ", "
-     << "time: " << this->time_ << " }" << std::endl;
+     << "time: " << this->time_ << ", "
+     << "weight: " << this->weight_ << " }" << std::endl;
   return os;
 }
 
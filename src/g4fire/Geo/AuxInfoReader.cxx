@@ -1,6 +1,8 @@
 #include "g4fire/Geo/AuxInfoReader.h"
 
 #include <stdlib.h>
+#include <fstream>
+#include <set>
 #include <string>
 
 #include "G4FieldManager.hh"
@@ -10,6 +12,7 @@
 #include "G4RegionStore.hh"
 #include "G4SDManager.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4TransportationManager.hh"
 #include "G4UniformMagField.hh"
 
 //#include "Framework/Exception/Exception.h"
@@ -59,10 +62,20 @@ void AuxInfoReader::readGlobalAuxInfo() {
       createRegion(aux_val, iaux->auxList);
     } else if (aux_type == "VisAttributes") {
       createVisAttributes(aux_val, iaux->auxList);
+    } else if (aux_type == "FieldIntegration") {
+      field_integrations_[aux_val].update(iaux->auxList, eval_.get());
     } /*else if (aux_type == "DetectorVersion") {
       createDetectorHeader(aux_val, iaux->auxList);
     }*/
   }
+
+  // The integration blocks may come after the field definitions,
+  // so the global field is configured once everything is read.
+  if (!global_field_.empty()) {
+    getFieldIntegration("field", global_field_, field_integration_refs_)
+        .apply(G4TransportationManager::GetTransportationManager()
+                   ->GetFieldManager());
+  }
   return;
 }
 
@@ -187,6 +200,10 @@ void AuxInfoReader::assignAuxInfoToVolumes() {
                   mag_field_name);
           if (mag_field != NULL) {
             G4FieldManager *mgr = new G4FieldManager(mag_field);
+            getFieldIntegration("field", mag_field_name,
+                                field_integration_refs_)
+                .apply(mgr);
+            volume_field_managers_[lv] = mgr;
             lv->SetFieldManager(mgr, true /* FIXME: hard-coded to force field manager to daughters */);
             // G4cout << "Assigned magnetic field " << mag_field_name << " to
             // volume " << lv->GetName() << G4endl;
@@ -231,6 +248,87 @@ void AuxInfoReader::assignAuxInfoToVolumes() {
       }
     }
   }
+
+  assignFieldIntegrationToRegions();
+}
+
+void AuxInfoReader::assignFieldIntegrationToRegions() {
+  std::set<std::string> region_names;
+  for (const auto &[region_name, block] : region_integration_refs_)
+    region_names.insert(region_name);
+  auto overrides{params_.get<std::vector<fire::config::Parameters>>(
+      "field_integration", {})};
+  for (const auto &override : overrides) {
+    auto region_name{override.get<std::string>("region", "")};
+    if (!region_name.empty())
+      region_names.insert(region_name);
+  }
+
+  for (const auto &region_name : region_names) {
+    auto settings{
+        getFieldIntegration("region", region_name, region_integration_refs_)};
+    if (settings.empty())
+      continue;
+
+    G4Region *region = G4RegionStore::GetInstance()->GetRegion(region_name);
+    if (region == NULL) {
+      throw fire::Exception("MissingInfo",
+                            "Field integration region '" + region_name +
+                                "' was not found!",
+                            false);
+    }
+
+    // The region uses its own copy of the global field so its settings
+    // don't leak into the rest of the world.
+    auto global_field{dynamic_cast<G4MagneticField *>(const_cast<G4Field *>(
+        G4TransportationManager::GetTransportationManager()
+            ->GetFieldManager()
+            ->GetDetectorField()))};
+    if (global_field != nullptr) {
+      // created with the magnetic field so it owns its chord finder
+      G4FieldManager *mgr = new G4FieldManager(global_field);
+      settings.apply(mgr);
+      region->SetFieldManager(mgr);
+    }
+
+    // Field managers of the volumes override the one of their region,
+    // so the region settings are applied on top of theirs.
+    auto root_volume{region->GetRootLogicalVolumeIterator()};
+    for (std::size_t i_root = 0; i_root < region->GetNumberOfRootVolumes();
+         i_root++, root_volume++) {
+      auto volume_mgr{volume_field_managers_.find(*root_volume)};
+      if (volume_mgr != volume_field_managers_.end())
+        settings.apply(volume_mgr->second);
+    }
+  }
+}
+
+FieldIntegration AuxInfoReader::getFieldIntegration(
+    const std::string &kind, const std::string &name,
+    const std::map<std::string, std::string> &refs) const {
+  FieldIntegration settings;
+
+  auto ref{refs.find(name)};
+  if (ref != refs.end()) {
+    auto block{field_integrations_.find(ref->second)};
+    if (block == field_integrations_.end()) {
+      throw fire::Exception("MissingInfo",
+                            "Referenced FieldIntegration '" + ref->second +
+                                "' was not found!",
+                            false);
+    }
+    settings.update(block->second);
+  }
+
+  // overrides from the configuration take precedence over the geometry
+  auto overrides{params_.get<std::vector<fire::config::Parameters>>(
+      "field_integration", {})};
+  for (const auto &override : overrides) {
+    if (override.get<std::string>(kind, "") == name)
+      settings.update(override);
+  }
+
+  return settings;
 }
 
 void AuxInfoReader::createMagneticField(
@@ -245,7 +343,8 @@ void AuxInfoReader::createMagneticField(
 
     if (aux_type == "MagneticFieldType") {
       mag_field_type = aux_val;
-      break;
+    } else if (aux_type == "FieldIntegration") {
+      field_integration_refs_[mag_field_name] = aux_val;
     }
   }
 
@@ -286,8 +385,9 @@ void AuxInfoReader::createMagneticField(
 
     // Create a global 3D field map by reading from a data file.
   } else if (mag_field_type == "MagneticFieldMap3D") {
-    std::string file_name;
+    std::string file_name, mirror_x, mirror_y;
     double offset_x, offset_y, offset_z;
+    bool single_precision{false};
 
     for (std::vector<G4GDMLAuxStructType>::const_iterator iaux =
              aux_info_list->begin();
@@ -306,6 +406,19 @@ void AuxInfoReader::createMagneticField(
         offset_y = eval_->Evaluate(expr);
       } else if (aux_type == "OffsetZ") {
         offset_z = eval_->Evaluate(expr);
+      } else if (aux_type == "MirrorX") {
+        mirror_x = aux_val;
+      } else if (aux_type == "MirrorY") {
+        mirror_y = aux_val;
+      } else if (aux_type == "Precision") {
+        if (aux_val != "float" and aux_val != "double") {
+          throw fire::Exception("BadValue",
+                                "Unknown field map precision '" +
+                                    std::string(aux_val.data()) +
+                                    "', options are 'float' or 'double'.",
+                                false);
+        }
+        single_precision = aux_val == "float";
       }
     }
 
@@ -314,9 +427,24 @@ void AuxInfoReader::createMagneticField(
           "MissingInfo", "File info with field data was not provided.", false);
     }
 
+    // Prefer the binary version of the map if it has been converted from
+    // the current text map, it is memory-mapped instead of parsed.
+    std::string binary_file_name{file_name + ".bin"};
+    if (std::ifstream(binary_file_name).good()) {
+      if (MagneticFieldMap3D::isConversionOf(binary_file_name, file_name)) {
+        file_name = binary_file_name;
+      } else {
+        std::cout << "[ AuxInfoReader ]: Ignoring '" << binary_file_name
+                  << "' since it was not converted from the current '"
+                  << file_name << "', run convert-field-map again."
+                  << std::endl;
+      }
+    }
+
     // Create new 3D field map.
     mag_field =
-        new MagneticFieldMap3D(file_name.c_str(), offset_x, offset_y, offset_z);
+        new MagneticFieldMap3D(file_name.c_str(), offset_x, offset_y, offset_z,
+                               single_precision, mirror_x, mirror_y);
 
     // Assign field map as global field.
     G4FieldManager *field_mgr =
@@ -327,6 +455,7 @@ void AuxInfoReader::createMagneticField(
     }
     field_mgr->SetDetectorField(mag_field);
     field_mgr->CreateChordFinder(mag_field);
+    global_field_ = mag_field_name;
 
   } else {
     throw fire::Exception("UnknownType",
@@ -356,6 +485,8 @@ void AuxInfoReader::createRegion(G4String name,
       } else if (aux_val == "true") {
         store_trajectories = true;
       }
+    } else if (aux_type == "FieldIntegration") {
+      region_integration_refs_[name] = aux_val;
     }
   }
 
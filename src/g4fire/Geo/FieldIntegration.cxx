@@ -0,0 +1,197 @@
+#include "g4fire/Geo/FieldIntegration.h"
+
+#include <memory>
+
+#include "G4BogackiShampine23.hh"
+#include "G4CashKarpRKF45.hh"
+#include "G4ChordFinder.hh"
+#include "G4ClassicalRK4.hh"
+#include "G4DormandPrince745.hh"
+#include "G4ExplicitEuler.hh"
+#include "G4FieldManager.hh"
+#include "G4GDMLEvaluator.hh"
+#include "G4HelixExplicitEuler.hh"
+#include "G4HelixImplicitEuler.hh"
+#include "G4HelixSimpleRunge.hh"
+#include "G4ImplicitEuler.hh"
+#include "G4Mag_UsualEqRhs.hh"
+#include "G4MagneticField.hh"
+#include "G4NystromRK4.hh"
+#include "G4SimpleHeum.hh"
+#include "G4SimpleRunge.hh"
+
+#include "fire/exception/Exception.h"
+
+namespace g4fire::geo {
+
+namespace {
+
+/**
+ * Create a stepper by the name of its class.
+ *
+ * @param[in] name The name of the stepper class without the G4 prefix.
+ * @param[in] equation The equation of motion to integrate.
+ * @return The new stepper.
+ */
+G4MagIntegratorStepper *createStepper(const std::string &name,
+                                      G4Mag_UsualEqRhs *equation) {
+  if (name == "ClassicalRK4")
+    return new G4ClassicalRK4(equation);
+  else if (name == "SimpleRunge")
+    return new G4SimpleRunge(equation);
+  else if (name == "SimpleHeum")
+    return new G4SimpleHeum(equation);
+  else if (name == "ExplicitEuler")
+    return new G4ExplicitEuler(equation);
+  else if (name == "ImplicitEuler")
+    return new G4ImplicitEuler(equation);
+  else if (name == "HelixExplicitEuler")
+    return new G4HelixExplicitEuler(equation);
+  else if (name == "HelixImplicitEuler")
+    return new G4HelixImplicitEuler(equation);
+  else if (name == "HelixSimpleRunge")
+    return new G4HelixSimpleRunge(equation);
+  else if (name == "CashKarpRKF45")
+    return new G4CashKarpRKF45(equation);
+  else if (name == "DormandPrince745")
+    return new G4DormandPrince745(equation);
+  else if (name == "BogackiShampine23")
+    return new G4BogackiShampine23(equation);
+  else if (name == "NystromRK4")
+    return new G4NystromRK4(equation);
+
+  throw fire::Exception("UnknownType",
+                        "Unknown field integration Stepper '" + name + "'.",
+                        false);
+}
+
+/**
+ * Chord finder integrating with a stepper of our choice.
+ *
+ * G4ChordFinder leaves a stepper it is given (and the equation of motion
+ * the stepper integrates) to the caller, this one deletes them with itself.
+ */
+class StepperChordFinder : public G4ChordFinder {
+public:
+  StepperChordFinder(G4MagneticField *field, double min_step,
+                     std::unique_ptr<G4Mag_UsualEqRhs> equation,
+                     std::unique_ptr<G4MagIntegratorStepper> stepper)
+      : G4ChordFinder(field, min_step, stepper.get()),
+        equation_{std::move(equation)}, stepper_{std::move(stepper)} {}
+
+private:
+  /// The equation of motion integrated by the stepper
+  std::unique_ptr<G4Mag_UsualEqRhs> equation_;
+
+  /// The stepper used by the driver of the chord finder
+  std::unique_ptr<G4MagIntegratorStepper> stepper_;
+};
+
+} // namespace
+
+void FieldIntegration::update(const G4GDMLAuxListType *aux_info_list,
+                              G4GDMLEvaluator *eval) {
+  for (std::vector<G4GDMLAuxStructType>::const_iterator iaux =
+           aux_info_list->begin();
+       iaux != aux_info_list->end(); iaux++) {
+    G4String aux_type = iaux->type;
+    G4String aux_val = iaux->value;
+    G4String aux_unit = iaux->unit;
+
+    if (aux_type == "Stepper") {
+      stepper_ = aux_val;
+      continue;
+    }
+
+    G4String expr = aux_unit.empty() ? aux_val : aux_val + "*" + aux_unit;
+    if (aux_type == "DeltaChord") {
+      delta_chord_ = eval->Evaluate(expr);
+    } else if (aux_type == "DeltaOneStep") {
+      delta_one_step_ = eval->Evaluate(expr);
+    } else if (aux_type == "DeltaIntersection") {
+      delta_intersection_ = eval->Evaluate(expr);
+    } else if (aux_type == "EpsilonMin") {
+      epsilon_min_ = eval->Evaluate(expr);
+    } else if (aux_type == "EpsilonMax") {
+      epsilon_max_ = eval->Evaluate(expr);
+    } else if (aux_type == "MinStep") {
+      min_step_ = eval->Evaluate(expr);
+    }
+  }
+}
+
+void FieldIntegration::update(const fire::config::Parameters &params) {
+  FieldIntegration overrides;
+  overrides.stepper_ = params.get<std::string>("stepper", "");
+  overrides.delta_chord_ = params.get<double>("delta_chord", -1.);
+  overrides.delta_one_step_ = params.get<double>("delta_one_step", -1.);
+  overrides.delta_intersection_ = params.get<double>("delta_intersection", -1.);
+  overrides.epsilon_min_ = params.get<double>("epsilon_min", -1.);
+  overrides.epsilon_max_ = params.get<double>("epsilon_max", -1.);
+  overrides.min_step_ = params.get<double>("min_step", -1.);
+  update(overrides);
+}
+
+void FieldIntegration::update(const FieldIntegration &other) {
+  if (!other.stepper_.empty())
+    stepper_ = other.stepper_;
+  if (other.delta_chord_ > 0.)
+    delta_chord_ = other.delta_chord_;
+  if (other.delta_one_step_ > 0.)
+    delta_one_step_ = other.delta_one_step_;
+  if (other.delta_intersection_ > 0.)
+    delta_intersection_ = other.delta_intersection_;
+  if (other.epsilon_min_ > 0.)
+    epsilon_min_ = other.epsilon_min_;
+  if (other.epsilon_max_ > 0.)
+    epsilon_max_ = other.epsilon_max_;
+  if (other.min_step_ > 0.)
+    min_step_ = other.min_step_;
+}
+
+void FieldIntegration::apply(G4FieldManager *mgr) const {
+  if (!stepper_.empty() || min_step_ > 0.) {
+    auto field{dynamic_cast<G4MagneticField *>(
+        const_cast<G4Field *>(mgr->GetDetectorField()))};
+    if (field == nullptr) {
+      throw fire::Exception(
+          "MisAssign",
+          "Field integration stepper assigned to a manager without a "
+          "magnetic field.",
+          false);
+    }
+
+    // The manager only deletes the chord finder it holds when it is
+    // destroyed, so the one it is replacing is deleted here.
+    delete mgr->GetChordFinder();
+    double min_step{min_step_ > 0. ? min_step_ : 1.0e-2};
+    if (stepper_.empty()) {
+      mgr->SetChordFinder(new G4ChordFinder(field, min_step));
+    } else {
+      auto equation{std::make_unique<G4Mag_UsualEqRhs>(field)};
+      std::unique_ptr<G4MagIntegratorStepper> stepper{
+          createStepper(stepper_, equation.get())};
+      mgr->SetChordFinder(new StepperChordFinder(
+          field, min_step, std::move(equation), std::move(stepper)));
+    }
+  }
+
+  if (delta_chord_ > 0.)
+    mgr->GetChordFinder()->SetDeltaChord(delta_chord_);
+  if (delta_one_step_ > 0.)
+    mgr->SetDeltaOneStep(delta_one_step_);
+  if (delta_intersection_ > 0.)
+    mgr->SetDeltaIntersection(delta_intersection_);
+  if (epsilon_max_ > 0.)
+    mgr->SetMaximumEpsilonStep(epsilon_max_);
+  if (epsilon_min_ > 0.)
+    mgr->SetMinimumEpsilonStep(epsilon_min_);
+}
+
+bool FieldIntegration::empty() const {
+  return stepper_.empty() && delta_chord_ <= 0. && delta_one_step_ <= 0. &&
+         delta_intersection_ <= 0. && epsilon_min_ <= 0. &&
+         epsilon_max_ <= 0. && min_step_ <= 0.;
+}
+
+} // namespace g4fire::geo
@@ -18,6 +18,8 @@
 #include "G4Step.hh"
 #include "G4StepPoint.hh"
 
+#include "g4fire/UserTrackInformation.h"
+
 namespace g4fire {
 
 HcalSD::HcalSD(G4String name, G4String collectionName, int subDetID)
@@ -48,6 +50,9 @@ G4bool HcalSD::ProcessHits(G4Step* aStep, G4TouchableHistory* ROhist) {
     return false;
   }
 
+  // Skip steps that happen outside of the readout window.
+  if (!isInReadoutWindow(aStep)) return false;
+
   //---------------------------------------------------------------------------------------------------
   //                Birks' Law
   //                ===========
@@ -163,6 +168,9 @@ G4bool HcalSD::ProcessHits(G4Step* aStep, G4TouchableHistory* ROhist) {
   // Set the PDG code from the track.
   hit->setPdgCode(aStep->GetTrack()->GetParticleDefinition()->GetPDGEncoding());
 
+  // Set the weight of the track, it differs from one when biasing splits it.
+  hit->setWeight(UserTrackInformation::getHitWeight(aStep->GetTrack()));
+
   // do we want to set the hit coordinate in the middle of the absorber?
   // G4ThreeVector volumePosition =
   // aStep->GetPreStepPoint()->GetTouchableHandle()->GetHistory()->GetTopTransform().Inverse().TransformPoint(G4ThreeVector());
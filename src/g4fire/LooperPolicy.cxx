@@ -0,0 +1,155 @@
+#include "g4fire/LooperPolicy.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+#include "G4CoupledTransportation.hh"
+#include "G4EventManager.hh"
+#include "G4FieldManager.hh"
+#include "G4LogicalVolume.hh"
+#include "G4ParticleTable.hh"
+#include "G4ProcessManager.hh"
+#include "G4PropagatorInField.hh"
+#include "G4Transportation.hh"
+#include "G4TransportationManager.hh"
+#include "G4VProcess.hh"
+
+#include "g4fire/UserEventInformation.h"
+#include "g4fire/UserTrackInformation.h"
+
+namespace g4fire {
+
+LooperPolicy::LooperPolicy(
+    const std::vector<fire::config::Parameters> &policies) {
+  for (const auto &policy : policies) {
+    Thresholds thresholds{
+        policy.get<double>("warning_energy", 0.),
+        policy.get<double>("important_energy",
+                           std::numeric_limits<double>::max()),
+        policy.get<int>("max_looping_steps", 0)};
+    auto region{policy.get<std::string>("region", "")};
+    if (region.empty()) {
+      has_default_ = true;
+      default_ = thresholds;
+    } else
+      thresholds_[region] = thresholds;
+  }
+}
+
+void LooperPolicy::configureTransportation() const {
+  auto particles{G4ParticleTable::GetParticleTable()->GetIterator()};
+  particles->reset();
+  while ((*particles)()) {
+    auto manager{particles->value()->GetProcessManager()};
+    if (!manager) continue;
+    auto processes{manager->GetProcessList()};
+    for (std::size_t i{0}; i < processes->size(); ++i) {
+      auto process{(*processes)[i]};
+      if (auto coupled{dynamic_cast<G4CoupledTransportation *>(process)})
+        configure(coupled);
+      else if (auto transport{dynamic_cast<G4Transportation *>(process)})
+        configure(transport);
+    }
+  }
+}
+
+template <typename Transport>
+void LooperPolicy::configure(Transport *transport) const {
+  double important{has_default_ ? default_.warning_energy
+                                : transport->GetThresholdImportantEnergy()};
+  int trials{transport->GetThresholdTrials()};
+  bool limited{has_default_ and default_.max_looping_steps > 0};
+  if (has_default_) trials = std::max(trials, default_.max_looping_steps);
+  for (const auto &[region, thresholds] : thresholds_) {
+    important = std::min(important, thresholds.warning_energy);
+    trials = std::max(trials, thresholds.max_looping_steps);
+    limited = limited and thresholds.max_looping_steps > 0;
+  }
+  if (limited) trials = std::numeric_limits<int>::max();
+
+  transport->SetThresholdWarningEnergy(important);
+  transport->SetThresholdImportantEnergy(important);
+  transport->SetThresholdTrials(trials);
+  std::cout << "[ LooperPolicy ]: " << transport->GetProcessName()
+            << " kills loopers below " << important << " MeV right away and "
+            << "others after " << trials << " trials." << std::endl;
+}
+
+void LooperPolicy::stepping(const G4Step *step) {
+  auto process{step->GetPostStepPoint()->GetProcessDefinedStep()};
+  if (!process or process->GetProcessType() != fTransportation) return;
+
+  // the propagator only updates its looping flag when it integrates a
+  // charged track through a field, otherwise it is left over from an
+  // earlier track
+  auto track{step->GetTrack()};
+  auto field_manager{step->GetPreStepPoint()
+                         ->GetPhysicalVolume()
+                         ->GetLogicalVolume()
+                         ->GetFieldManager()};
+  if (!field_manager) {
+    field_manager =
+        G4TransportationManager::GetTransportationManager()->GetFieldManager();
+  }
+  if (track->GetDynamicParticle()->GetCharge() == 0. or !field_manager or
+      !field_manager->GetDetectorField()) {
+    if (track->GetTrackStatus() == fAlive)
+      UserTrackInformation::get(track)->resetLoopingSteps();
+    return;
+  }
+
+  bool looping{G4TransportationManager::GetTransportationManager()
+                   ->GetPropagatorInField()
+                   ->IsParticleLooping()};
+
+  // tracks that are already stopped were handled by Geant4 itself, which
+  // still kills the loopers beyond its own thresholds
+  if (track->GetTrackStatus() != fAlive) {
+    if (looping and track->GetTrackStatus() == fStopAndKill) {
+      static_cast<UserEventInformation *>(
+          G4EventManager::GetEventManager()->GetUserInformation())
+          ->addKilledLooper(track->GetKineticEnergy());
+    }
+    return;
+  }
+
+  auto track_info{UserTrackInformation::get(track)};
+  if (!looping) {
+    track_info->resetLoopingSteps();
+    return;
+  }
+
+  int looping_steps{track_info->incLoopingSteps()};
+  auto thresholds{getThresholds(
+      step->GetPreStepPoint()->GetPhysicalVolume()->GetLogicalVolume()
+          ->GetRegion())};
+  if (!thresholds) return;
+
+  double energy{track->GetKineticEnergy()};
+  if (energy >= thresholds->important_energy) return;
+  if (energy < thresholds->warning_energy or
+      (thresholds->max_looping_steps > 0 and
+       looping_steps >= thresholds->max_looping_steps)) {
+    track->SetTrackStatus(fStopAndKill);
+    static_cast<UserEventInformation *>(
+        G4EventManager::GetEventManager()->GetUserInformation())
+        ->addKilledLooper(energy);
+  }
+}
+
+const LooperPolicy::Thresholds *LooperPolicy::getThresholds(
+    const G4Region *region) {
+  auto cached{by_region_.find(region)};
+  if (cached != by_region_.end()) return cached->second;
+
+  const Thresholds *thresholds{has_default_ ? &default_ : nullptr};
+  if (region) {
+    auto named{thresholds_.find(region->GetName())};
+    if (named != thresholds_.end()) thresholds = &named->second;
+  }
+  by_region_[region] = thresholds;
+  return thresholds;
+}
+
+}  // namespace g4fire
@@ -2,7 +2,16 @@
 
 #include "fire/exception/Exception.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <string>
@@ -14,10 +23,225 @@ using namespace std;
 
 namespace g4fire {
 
+namespace {
+
+/**
+ * Field values at the corners of the most recently used grid cell.
+ */
+struct CellCache {
+  /// identifier of the map the cell belongs to (0 is never used by a map)
+  unsigned long mapID{0};
+  /// flat index of the lowest corner of the cell
+  long cell{-1};
+  /// field values at the eight corners of the cell
+  double corners[8][3];
+};
+
+/// each thread integrates its own tracks, so each has its own cache
+thread_local CellCache cellCache;
+
+/// source of unique map identifiers
+std::atomic<unsigned long> nextMapID{1};
+
+/// identifies a binary field map, the trailing characters are NUL
+const char BINARY_MAGIC[8] = {'G', '4', 'F', 'B', 'M', 'A', 'P', '\0'};
+
+/// version of the binary layout written by this code
+const uint32_t BINARY_VERSION = 4;
+
+/**
+ * Header at the start of a binary field map.
+ *
+ * The grid values follow the header directly, in the same interleaved
+ * layout (and with the same precision) as they are held in memory.
+ * The limits are stored after any reordering, i.e. min < max and the
+ * inversion flags record which axes were reordered.
+ */
+struct BinaryHeader {
+  char magic[8];
+  uint32_t version;
+  /// size of a single stored value in bytes (4 or 8)
+  uint32_t valueSize;
+  int32_t nx, ny, nz;
+  /// bit 0, 1 and 2 are set if the x, y and z axes are inverted
+  uint32_t invert;
+  double min[3];
+  double max[3];
+  /// offsets of the map when it was written, informational only since
+  /// the offsets are configured by the geometry
+  double offset[3];
+  /// bit 0 and 1 are set if the map is mirrored in x and y
+  uint32_t mirror;
+  uint32_t padding;
+  /// signs of the field components in the mirrored halves (x, then y)
+  double mirrorSigns[2][3];
+  /// size [bytes] and modification time [s] of the converted text map
+  uint64_t sourceSize;
+  int64_t sourceModified;
+  /// FNV-1a hash of the grid values
+  uint64_t checksum;
+};
+
+/**
+ * 64-bit FNV-1a hash of a block of memory.
+ *
+ * @param[in] data start of the block
+ * @param[in] size number of bytes in the block
+ * @return hash of the block
+ */
+uint64_t checksum(const void *data, std::size_t size) {
+  auto bytes = static_cast<const unsigned char *>(data);
+  uint64_t hash = 14695981039346656037ull;
+  for (std::size_t i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+/**
+ * Check if the input file starts with the binary field map magic.
+ *
+ * @param[in] filename path to the file
+ * @return true if the file is a binary field map
+ */
+bool isBinary(const char *filename) {
+  ifstream file(filename, ios::binary);
+  char magic[sizeof(BINARY_MAGIC)];
+  if (!file.read(magic, sizeof(magic))) return false;
+  return std::memcmp(magic, BINARY_MAGIC, sizeof(magic)) == 0;
+}
+
+/**
+ * Parse the per-component sign rule of a mirror symmetry.
+ *
+ * @param[in] rule signs of the x, y and z components of the field in
+ *  the mirrored half (e.g. "-++"), empty if there is no symmetry
+ * @param[out] signs the parsed signs, +1 or -1
+ * @return true if a symmetry was declared
+ */
+bool parseMirror(const std::string &rule, double signs[3]) {
+  signs[0] = signs[1] = signs[2] = 1.;
+  if (rule.empty()) return false;
+  if (rule.size() != 3 or
+      rule.find_first_not_of("+-") != std::string::npos) {
+    throw fire::Exception("BadSymmetry",
+                          "Mirror symmetry rule '" + rule +
+                              "' is not three signs (e.g. '-++').",
+                          false);
+  }
+  for (int iComp = 0; iComp < 3; iComp++)
+    signs[iComp] = rule[iComp] == '-' ? -1. : 1.;
+  return true;
+}
+
+/**
+ * Find the range of grid indices along one axis with non-negative
+ * coordinates.
+ *
+ * The coordinates are evenly spaced, so the kept indices are contiguous.
+ *
+ * @param[in] n number of grid points along the axis
+ * @param[in,out] first coordinate of the first grid point
+ * @param[in,out] last coordinate of the last grid point
+ * @param[out] lo first index to keep
+ * @return number of indices to keep
+ */
+int nonNegativeRange(int n, double &first, double &last, int &lo) {
+  const double eps = 1E-6;
+  double step = (last - first) / (n - 1);
+  int hi = -1;
+  lo = n;
+  for (int i = 0; i < n; i++) {
+    if (first + i * step >= -eps) {
+      lo = std::min(lo, i);
+      hi = i;
+    }
+  }
+
+  double newFirst = first + lo * step;
+  double newLast = first + hi * step;
+  if (hi - lo < 1 or std::min(newFirst, newLast) > eps) {
+    throw fire::Exception("BadSymmetry",
+                          "Mirrored field maps must contain their mirror "
+                          "plane and at least two grid points beyond it.",
+                          false);
+  }
+
+  // snap the mirror plane onto zero so it stays inside the map
+  first = std::abs(newFirst) <= eps ? 0. : newFirst;
+  last = std::abs(newLast) <= eps ? 0. : newLast;
+  return hi - lo + 1;
+}
+
+/**
+ * Keep only a box of grid points, in place.
+ *
+ * The grid is compacted from the front, so each kept row is moved to
+ * an index at or before its original one.
+ *
+ * @param[in,out] grid interleaved grid values, z changing fastest
+ * @param[in] ny number of grid points along y before the reduction
+ * @param[in] rowSize number of values along z (all of which are kept)
+ * @param[in] xlo first x index to keep
+ * @param[in] nx number of x indices to keep
+ * @param[in] ylo first y index to keep
+ * @param[in] nyKept number of y indices to keep
+ */
+template <typename T>
+void keepBox(std::vector<T> &grid, int ny, std::size_t rowSize, int xlo,
+             int nx, int ylo, int nyKept) {
+  auto out = grid.begin();
+  for (int ix = 0; ix < nx; ix++) {
+    for (int iy = 0; iy < nyKept; iy++) {
+      auto row =
+          grid.begin() + (std::size_t(xlo + ix) * ny + ylo + iy) * rowSize;
+      out = std::copy(row, row + rowSize, out);
+    }
+  }
+  grid.erase(out, grid.end());
+  grid.shrink_to_fit();
+}
+
+}  // namespace
+
 MagneticFieldMap3D::MagneticFieldMap3D(const char *filename, double xOffset,
-                                       double yOffset, double zOffset)
+                                       double yOffset, double zOffset,
+                                       bool singlePrecision,
+                                       const std::string &mirrorX,
+                                       const std::string &mirrorY)
     : nx_(0), ny_(0), nz_(0), xOffset_(xOffset), yOffset_(yOffset),
       zOffset_(zOffset), invertX_(false), invertY_(false), invertZ_(false) {
+  id_ = nextMapID++;
+  mirrorX_ = parseMirror(mirrorX, mirrorXSigns_);
+  mirrorY_ = parseMirror(mirrorY, mirrorYSigns_);
+
+  G4cout << "-----------------------------------------------------------"
+         << G4endl;
+  G4cout << "    Magnetic Field Map 3D" << G4endl;
+  G4cout << "-----------------------------------------------------------"
+         << G4endl << G4endl;
+
+  if (isBinary(filename))
+    readBinary(filename);
+  else
+    readText(filename, singlePrecision);
+
+  for (int iCorner = 0; iCorner < 8; iCorner++) {
+    long cx = (iCorner >> 2) & 1, cy = (iCorner >> 1) & 1, cz = iCorner & 1;
+    cornerOffsets_[iCorner] = ((cx * ny_ + cy) * nz_ + cz) * COMPONENTS;
+  }
+
+  G4cout << "Done loading field map" << G4endl << G4endl;
+  G4cout << "-----------------------------------------------------------"
+         << G4endl << G4endl;
+}
+
+MagneticFieldMap3D::Mapping::~Mapping() {
+  if (data) munmap(data, size);
+}
+
+void MagneticFieldMap3D::readText(const char *filename, bool singlePrecision) {
   ifstream file(filename); // Open the file for reading.
 
   // Throw an error if file does not exist.
@@ -28,14 +252,14 @@ MagneticFieldMap3D::MagneticFieldMap3D(const char *filename, double xOffset,
                           false);
   }
 
-  G4cout << "-----------------------------------------------------------"
-         << G4endl;
-  G4cout << "    Magnetic Field Map 3D" << G4endl;
-  G4cout << "-----------------------------------------------------------"
-         << G4endl << G4endl;
+  struct stat info;
+  if (stat(filename, &info) == 0) {
+    sourceSize_ = info.st_size;
+    sourceModified_ = info.st_mtime;
+  }
 
   G4cout << "Reading the field grid from " << filename << " ... " << endl;
-  G4cout << "  Offsets: " << xOffset << " " << yOffset << " " << zOffset
+  G4cout << "  Offsets: " << xOffset_ << " " << yOffset_ << " " << zOffset_
          << G4endl;
 
   // Ignore first blank line
@@ -48,20 +272,12 @@ MagneticFieldMap3D::MagneticFieldMap3D(const char *filename, double xOffset,
   G4cout << "  Number of values: " << nx_ << " " << ny_ << " " << nz_ << G4endl;
 
   // Set up storage space for table
-  xField_.resize(nx_);
-  yField_.resize(nx_);
-  zField_.resize(nx_);
+  std::size_t nValues = std::size_t(nx_) * ny_ * nz_ * COMPONENTS;
+  if (singlePrecision)
+    gridFloat_.assign(nValues, 0.);
+  else
+    grid_.assign(nValues, 0.);
   int ix, iy, iz;
-  for (ix = 0; ix < nx_; ix++) {
-    xField_[ix].resize(ny_);
-    yField_[ix].resize(ny_);
-    zField_[ix].resize(ny_);
-    for (iy = 0; iy < ny_; iy++) {
-      xField_[ix][iy].resize(nz_);
-      yField_[ix][iy].resize(nz_);
-      zField_[ix][iy].resize(nz_);
-    }
-  }
 
   // Ignore other header information
   // The first line whose second character is '0' is considered to
@@ -81,9 +297,17 @@ MagneticFieldMap3D::MagneticFieldMap3D(const char *filename, double xOffset,
           miny_ = yval;
           minz_ = zval;
         }
-        xField_[ix][iy][iz] = bx;
-        yField_[ix][iy][iz] = by;
-        zField_[ix][iy][iz] = bz;
+        std::size_t index =
+            ((std::size_t(ix) * ny_ + iy) * nz_ + iz) * COMPONENTS;
+        if (singlePrecision) {
+          gridFloat_[index] = bx;
+          gridFloat_[index + 1] = by;
+          gridFloat_[index + 2] = bz;
+        } else {
+          grid_[index] = bx;
+          grid_[index + 1] = by;
+          grid_[index + 2] = bz;
+        }
       }
     }
   }
@@ -103,6 +327,8 @@ MagneticFieldMap3D::MagneticFieldMap3D(const char *filename, double xOffset,
   G4cout << "  Field offsets: " << xOffset_ << " " << yOffset_ << " "
          << zOffset_ << " mm " << G4endl << G4endl;
 
+  if (mirrorX_ or mirrorY_) reduceToFundamentalRegion();
+
   // Should really check that the limits are not the wrong way around.
   if (maxx_ < minx_) {
     swap(maxx_, minx_);
@@ -130,9 +356,220 @@ MagneticFieldMap3D::MagneticFieldMap3D(const char *filename, double xOffset,
 
   G4cout << "  Range of values: " << dx_ << " " << dy_ << " " << dz_ << " mm"
          << G4endl << G4endl;
-  G4cout << "Done loading field map" << G4endl << G4endl;
-  G4cout << "-----------------------------------------------------------"
-         << G4endl << G4endl;
+
+  if (singlePrecision)
+    valuesFloat_ = gridFloat_.data();
+  else
+    values_ = grid_.data();
+}
+
+void MagneticFieldMap3D::reduceToFundamentalRegion() {
+  int xlo = 0, nx = nx_, ylo = 0, ny = ny_;
+  if (mirrorX_) nx = nonNegativeRange(nx_, minx_, maxx_, xlo);
+  if (mirrorY_) ny = nonNegativeRange(ny_, miny_, maxy_, ylo);
+
+  std::size_t rowSize = std::size_t(nz_) * COMPONENTS;
+  if (gridFloat_.empty())
+    keepBox(grid_, ny_, rowSize, xlo, nx, ylo, ny);
+  else
+    keepBox(gridFloat_, ny_, rowSize, xlo, nx, ylo, ny);
+
+  G4cout << "Reduced to the fundamental region of the mirror symmetries"
+         << G4endl;
+  G4cout << "  Number of values: " << nx << " " << ny << " " << nz_ << G4endl;
+  G4cout << "  Stored fraction: "
+         << double(nx) * ny / (double(nx_) * ny_) << G4endl << G4endl;
+
+  nx_ = nx;
+  ny_ = ny;
+}
+
+void MagneticFieldMap3D::readBinary(const char *filename) {
+  G4cout << "Mapping the binary field grid from " << filename << " ... "
+         << G4endl;
+
+  int fd = open(filename, O_RDONLY);
+  if (fd < 0) {
+    throw fire::Exception("FileDNE",
+                          "The field map file '" + std::string(filename) +
+                              "' could not be opened!",
+                          false);
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 or
+      std::size_t(info.st_size) < sizeof(BinaryHeader)) {
+    close(fd);
+    throw fire::Exception("BadFieldMap",
+                          "The field map file '" + std::string(filename) +
+                              "' is too short to be a binary field map.",
+                          false);
+  }
+
+  // Map the file read-only and shared so that all processes on a node
+  // using the same map are backed by the same physical pages.
+  void *mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    throw fire::Exception("BadFieldMap",
+                          "Unable to map the field map file '" +
+                              std::string(filename) + "' into memory.",
+                          false);
+  }
+  // owned from here on, so it is unmapped if any check below throws
+  mapping_.data = mapping;
+  mapping_.size = info.st_size;
+
+  const auto &header = *static_cast<const BinaryHeader *>(mapping_.data);
+  if (header.version != BINARY_VERSION) {
+    throw fire::Exception(
+        "BadFieldMap",
+        "The binary field map '" + std::string(filename) + "' has version " +
+            std::to_string(header.version) + " but version " +
+            std::to_string(BINARY_VERSION) + " is expected.",
+        false);
+  }
+
+  if (header.valueSize != sizeof(float) and
+      header.valueSize != sizeof(double)) {
+    throw fire::Exception("BadFieldMap",
+                          "The binary field map '" + std::string(filename) +
+                              "' stores values of unsupported size " +
+                              std::to_string(header.valueSize) + ".",
+                          false);
+  }
+
+  nx_ = header.nx;
+  ny_ = header.ny;
+  nz_ = header.nz;
+  std::size_t gridSize =
+      std::size_t(nx_) * ny_ * nz_ * COMPONENTS * header.valueSize;
+  if (nx_ < 2 or ny_ < 2 or nz_ < 2 or
+      mapping_.size != sizeof(BinaryHeader) + gridSize) {
+    throw fire::Exception("BadFieldMap",
+                          "The size of the binary field map '" +
+                              std::string(filename) +
+                              "' does not match its grid dimensions.",
+                          false);
+  }
+
+  const void *grid =
+      static_cast<const char *>(mapping_.data) + sizeof(BinaryHeader);
+  if (checksum(grid, gridSize) != header.checksum) {
+    throw fire::Exception("BadFieldMap",
+                          "The checksum of the binary field map '" +
+                              std::string(filename) +
+                              "' does not match its contents.",
+                          false);
+  }
+
+  if (header.valueSize == sizeof(float))
+    valuesFloat_ = static_cast<const float *>(grid);
+  else
+    values_ = static_cast<const double *>(grid);
+
+  minx_ = header.min[0];
+  miny_ = header.min[1];
+  minz_ = header.min[2];
+  maxx_ = header.max[0];
+  maxy_ = header.max[1];
+  maxz_ = header.max[2];
+  invertX_ = header.invert & 1;
+  invertY_ = header.invert & 2;
+  invertZ_ = header.invert & 4;
+  sourceSize_ = header.sourceSize;
+  sourceModified_ = header.sourceModified;
+
+  // the grid only holds the fundamental region of the symmetries it was
+  // written with, so they can't be changed afterwards
+  bool mirrorX = header.mirror & 1, mirrorY = header.mirror & 2;
+  bool sameSigns = true;
+  for (int iComp = 0; iComp < 3; iComp++) {
+    sameSigns = sameSigns and
+                (not mirrorX or
+                 header.mirrorSigns[0][iComp] == mirrorXSigns_[iComp]) and
+                (not mirrorY or
+                 header.mirrorSigns[1][iComp] == mirrorYSigns_[iComp]);
+  }
+  if (mirrorX != mirrorX_ or mirrorY != mirrorY_ or not sameSigns) {
+    throw fire::Exception("BadSymmetry",
+                          "The symmetries of the binary field map '" +
+                              std::string(filename) +
+                              "' differ from the configured ones, convert "
+                              "the map again with the configured symmetries.",
+                          false);
+  }
+
+  dx_ = maxx_ - minx_;
+  dy_ = maxy_ - miny_;
+  dz_ = maxz_ - minz_;
+
+  G4cout << "  Number of values: " << nx_ << " " << ny_ << " " << nz_ << G4endl;
+  G4cout << "  Min values: " << minx_ << " " << miny_ << " " << minz_ << " mm "
+         << G4endl;
+  G4cout << "  Max values: " << maxx_ << " " << maxy_ << " " << maxz_ << " mm "
+         << G4endl;
+  G4cout << "  Field offsets: " << xOffset_ << " " << yOffset_ << " "
+         << zOffset_ << " mm " << G4endl << G4endl;
+}
+
+void MagneticFieldMap3D::writeBinary(const std::string &filename) const {
+  BinaryHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, BINARY_MAGIC, sizeof(header.magic));
+  header.version = BINARY_VERSION;
+  header.valueSize = valuesFloat_ ? sizeof(float) : sizeof(double);
+  header.nx = nx_;
+  header.ny = ny_;
+  header.nz = nz_;
+  header.invert = (invertX_ ? 1 : 0) | (invertY_ ? 2 : 0) | (invertZ_ ? 4 : 0);
+  header.min[0] = minx_;
+  header.min[1] = miny_;
+  header.min[2] = minz_;
+  header.max[0] = maxx_;
+  header.max[1] = maxy_;
+  header.max[2] = maxz_;
+  header.offset[0] = xOffset_;
+  header.offset[1] = yOffset_;
+  header.offset[2] = zOffset_;
+  header.mirror = (mirrorX_ ? 1 : 0) | (mirrorY_ ? 2 : 0);
+  for (int iComp = 0; iComp < 3; iComp++) {
+    header.mirrorSigns[0][iComp] = mirrorXSigns_[iComp];
+    header.mirrorSigns[1][iComp] = mirrorYSigns_[iComp];
+  }
+  header.sourceSize = sourceSize_;
+  header.sourceModified = sourceModified_;
+
+  const char *grid = valuesFloat_ ? reinterpret_cast<const char *>(valuesFloat_)
+                                  : reinterpret_cast<const char *>(values_);
+  std::size_t gridSize =
+      std::size_t(nx_) * ny_ * nz_ * COMPONENTS * header.valueSize;
+  header.checksum = checksum(grid, gridSize);
+
+  ofstream file(filename, ios::binary | ios::trunc);
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file.write(grid, gridSize);
+  if (!file.good()) {
+    throw fire::Exception("FileWrite",
+                          "Unable to write the binary field map '" + filename +
+                              "'.",
+                          false);
+  }
+}
+
+bool MagneticFieldMap3D::isConversionOf(const std::string &binary,
+                                        const std::string &source) {
+  struct stat info;
+  if (stat(source.c_str(), &info) != 0) return false;
+
+  BinaryHeader header;
+  ifstream file(binary, ios::binary);
+  if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)))
+    return false;
+  return std::memcmp(header.magic, BINARY_MAGIC, sizeof(header.magic)) == 0 and
+         header.version == BINARY_VERSION and
+         header.sourceSize == uint64_t(info.st_size) and
+         header.sourceModified == int64_t(info.st_mtime);
 }
 
 void MagneticFieldMap3D::GetFieldValue(const double point[4],
@@ -142,6 +579,19 @@ void MagneticFieldMap3D::GetFieldValue(const double point[4],
   double z = point[2] - zOffset_;
   double eps = 1E-6;
 
+  // Fold the point into the fundamental region of the symmetries
+  double signs[3] = {1., 1., 1.};
+  if (mirrorX_ && x < 0) {
+    x = -x;
+    for (int iComp = 0; iComp < 3; iComp++)
+      signs[iComp] *= mirrorXSigns_[iComp];
+  }
+  if (mirrorY_ && y < 0) {
+    y = -y;
+    for (int iComp = 0; iComp < 3; iComp++)
+      signs[iComp] *= mirrorYSigns_[iComp];
+  }
+
   // Check that the point is within the defined region
   if (x >= minx_ && x < maxx_ - eps && y >= miny_ && y < maxy_ - eps &&
       z >= minz_ && z < maxz_ - eps) {
@@ -177,72 +627,35 @@ void MagneticFieldMap3D::GetFieldValue(const double point[4],
     int yindex = static_cast<int>(ydindex);
     int zindex = static_cast<int>(zdindex);
 
-#ifdef DEBUG_INTERPOLATING_FIELD
-    G4cout << "Local x,y,z: " << xlocal << " " << ylocal << " " << zlocal
-           << G4endl;
-    G4cout << "Index x,y,z: " << xindex << " " << yindex << " " << zindex
-           << G4endl;
-    double valx0z0, mulx0z0, valx1z0, mulx1z0;
-    double valx0z1, mulx0z1, valx1z1, mulx1z1;
-    valx0z0 = table[xindex][0][zindex];
-    mulx0z0 = (1 - xlocal) * (1 - zlocal);
-    valx1z0 = table[xindex + 1][0][zindex];
-    mulx1z0 = xlocal * (1 - zlocal);
-    valx0z1 = table[xindex][0][zindex + 1];
-    mulx0z1 = (1 - xlocal) * zlocal;
-    valx1z1 = table[xindex + 1][0][zindex + 1];
-    mulx1z1 = xlocal * zlocal;
-#endif
-
-    // Full 3-dimensional version
-    bfield[0] =
-        xField_[xindex][yindex][zindex] * (1 - xlocal) * (1 - ylocal) *
-            (1 - zlocal) +
-        xField_[xindex][yindex][zindex + 1] * (1 - xlocal) * (1 - ylocal) *
-            zlocal +
-        xField_[xindex][yindex + 1][zindex] * (1 - xlocal) * ylocal *
-            (1 - zlocal) +
-        xField_[xindex][yindex + 1][zindex + 1] * (1 - xlocal) * ylocal *
-            zlocal +
-        xField_[xindex + 1][yindex][zindex] * xlocal * (1 - ylocal) *
-            (1 - zlocal) +
-        xField_[xindex + 1][yindex][zindex + 1] * xlocal * (1 - ylocal) *
-            zlocal +
-        xField_[xindex + 1][yindex + 1][zindex] * xlocal * ylocal *
-            (1 - zlocal) +
-        xField_[xindex + 1][yindex + 1][zindex + 1] * xlocal * ylocal * zlocal;
-    bfield[1] =
-        yField_[xindex][yindex][zindex] * (1 - xlocal) * (1 - ylocal) *
-            (1 - zlocal) +
-        yField_[xindex][yindex][zindex + 1] * (1 - xlocal) * (1 - ylocal) *
-            zlocal +
-        yField_[xindex][yindex + 1][zindex] * (1 - xlocal) * ylocal *
-            (1 - zlocal) +
-        yField_[xindex][yindex + 1][zindex + 1] * (1 - xlocal) * ylocal *
-            zlocal +
-        yField_[xindex + 1][yindex][zindex] * xlocal * (1 - ylocal) *
-            (1 - zlocal) +
-        yField_[xindex + 1][yindex][zindex + 1] * xlocal * (1 - ylocal) *
-            zlocal +
-        yField_[xindex + 1][yindex + 1][zindex] * xlocal * ylocal *
-            (1 - zlocal) +
-        yField_[xindex + 1][yindex + 1][zindex + 1] * xlocal * ylocal * zlocal;
-    bfield[2] =
-        zField_[xindex][yindex][zindex] * (1 - xlocal) * (1 - ylocal) *
-            (1 - zlocal) +
-        zField_[xindex][yindex][zindex + 1] * (1 - xlocal) * (1 - ylocal) *
-            zlocal +
-        zField_[xindex][yindex + 1][zindex] * (1 - xlocal) * ylocal *
-            (1 - zlocal) +
-        zField_[xindex][yindex + 1][zindex + 1] * (1 - xlocal) * ylocal *
-            zlocal +
-        zField_[xindex + 1][yindex][zindex] * xlocal * (1 - ylocal) *
-            (1 - zlocal) +
-        zField_[xindex + 1][yindex][zindex + 1] * xlocal * (1 - ylocal) *
-            zlocal +
-        zField_[xindex + 1][yindex + 1][zindex] * xlocal * ylocal *
-            (1 - zlocal) +
-        zField_[xindex + 1][yindex + 1][zindex + 1] * xlocal * ylocal * zlocal;
+    // Load the corners of this cell unless they are already cached
+    long cell = (long(xindex) * ny_ + yindex) * nz_ + zindex;
+    CellCache &cache = cellCache;
+    if (cache.mapID != id_ || cache.cell != cell) {
+      if (valuesFloat_)
+        gatherCorners(valuesFloat_, cell, cache.corners);
+      else
+        gatherCorners(values_, cell, cache.corners);
+      cache.mapID = id_;
+      cache.cell = cell;
+    }
+
+    // Trilinear weights of the corners, in the same order as the corners
+    double weights[8];
+    for (int iCorner = 0; iCorner < 8; iCorner++) {
+      weights[iCorner] = ((iCorner & 4) ? xlocal : 1 - xlocal) *
+                         ((iCorner & 2) ? ylocal : 1 - ylocal) *
+                         ((iCorner & 1) ? zlocal : 1 - zlocal);
+    }
+
+    // Full 3-dimensional version, all components at once
+    double field[COMPONENTS] = {0., 0., 0.};
+    for (int iCorner = 0; iCorner < 8; iCorner++) {
+      for (int iComp = 0; iComp < COMPONENTS; iComp++)
+        field[iComp] += weights[iCorner] * cache.corners[iCorner][iComp];
+    }
+    bfield[0] = signs[0] * field[0];
+    bfield[1] = signs[1] * field[1];
+    bfield[2] = signs[2] * field[2];
 
   } else {
     bfield[0] = 0.0;
@@ -0,0 +1,53 @@
+#include "g4fire/Persist/CollectionSelection.h"
+
+namespace g4fire {
+namespace persist {
+
+CollectionSelection::CollectionSelection(
+    const std::vector<std::string> &drop,
+    const std::vector<std::string> &keep_if_filtered) {
+  for (const auto &pattern : drop) drop_.emplace_back(pattern);
+  for (const auto &pattern : keep_if_filtered)
+    keep_if_filtered_.emplace_back(pattern);
+}
+
+bool CollectionSelection::isDropped(const std::string &name) const {
+  return decide(name) == Decision::drop;
+}
+
+bool CollectionSelection::keep(const std::string &name,
+                               bool passed_filter) const {
+  auto decision{decide(name)};
+  if (decision == Decision::keep_if_filtered) return passed_filter;
+  return decision == Decision::keep;
+}
+
+CollectionSelection::Decision CollectionSelection::decide(
+    const std::string &name) const {
+  auto cached{decisions_.find(name)};
+  if (cached != decisions_.end()) return cached->second;
+
+  // dropping takes precedence over keeping filtered events
+  Decision decision{Decision::keep};
+  for (const auto &pattern : drop_) {
+    if (std::regex_match(name, pattern)) {
+      decision = Decision::drop;
+      break;
+    }
+  }
+
+  if (decision == Decision::keep) {
+    for (const auto &pattern : keep_if_filtered_) {
+      if (std::regex_match(name, pattern)) {
+        decision = Decision::keep_if_filtered;
+        break;
+      }
+    }
+  }
+
+  decisions_[name] = decision;
+  return decision;
+}
+
+}  // namespace persist
+}  // namespace g4fire
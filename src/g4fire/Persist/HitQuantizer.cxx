@@ -0,0 +1,72 @@
+#include "g4fire/Persist/HitQuantizer.h"
+
+/*~~~~~~~~~~~~~~~*/
+/*   Framework   */
+/*~~~~~~~~~~~~~~~*/
+#include "Framework/Exception/Exception.h"
+
+namespace g4fire {
+namespace persist {
+
+HitQuantizer::HitQuantizer(const framework::config::Parameters &parameters) {
+  collection_ = parameters.getParameter<std::string>("collection");
+
+  auto mode{parameters.getParameter<std::string>("mode", "fixed")};
+  if (mode == "fixed")
+    mode_ = Mode::fixed;
+  else if (mode == "float16")
+    mode_ = Mode::float16;
+  else {
+    EXCEPTION_RAISE("Quantization", "Unknown quantization mode '" + mode +
+                                        "' for collection '" + collection_ +
+                                        "'. Options are 'fixed' or 'float16'.");
+  }
+
+  steps_.position = parameters.getParameter<double>("position", 0.);
+  steps_.momentum = parameters.getParameter<double>("momentum", 0.);
+  steps_.energy = parameters.getParameter<double>("energy", 0.);
+  steps_.edep = parameters.getParameter<double>("edep", 0.);
+  steps_.time = parameters.getParameter<double>("time", 0.);
+  steps_.pathLength = parameters.getParameter<double>("path_length", 0.);
+}
+
+void HitQuantizer::add(const std::vector<ldmx::SimTrackerHit> &hits,
+                       framework::Event &event) const {
+  if (mode_ == Mode::float16)
+    add<ldmx::HalfSimTrackerHitColumns>(hits, event);
+  else
+    add<ldmx::FixedSimTrackerHitColumns>(hits, event);
+}
+
+void HitQuantizer::add(const std::vector<ldmx::SimCalorimeterHit> &hits,
+                       framework::Event &event) const {
+  if (mode_ == Mode::float16)
+    add<ldmx::HalfSimCalorimeterHitColumns>(hits, event);
+  else
+    add<ldmx::FixedSimCalorimeterHitColumns>(hits, event);
+}
+
+void HitQuantizer::record(ldmx::RunHeader &header) const {
+  std::string prefix{"Quantization::" + collection_ + "::"};
+  header.setStringParameter(prefix + "Mode",
+                            mode_ == Mode::float16 ? "float16" : "fixed");
+  if (mode_ == Mode::float16) return;
+  header.setFloatParameter(prefix + "Position Step [mm]", steps_.position);
+  header.setFloatParameter(prefix + "Momentum Step [MeV]", steps_.momentum);
+  header.setFloatParameter(prefix + "Energy Step [MeV]", steps_.energy);
+  header.setFloatParameter(prefix + "Edep Step [MeV]", steps_.edep);
+  header.setFloatParameter(prefix + "Time Step [ns]", steps_.time);
+  header.setFloatParameter(prefix + "Path Length Step [mm]",
+                           steps_.pathLength);
+}
+
+template <typename Columns, typename Hit>
+void HitQuantizer::add(const std::vector<Hit> &hits,
+                       framework::Event &event) const {
+  Columns columns;
+  columns.fill(hits, steps_);
+  event.add(collection_, columns);
+}
+
+}  // namespace persist
+}  // namespace g4fire
@@ -6,6 +6,7 @@
 /*~~~~~~~~~~~~~~~~*/
 #include <algorithm>
 #include <memory>
+#include <sstream>
 
 /*~~~~~~~~~~~*/
 /*   Event   */
@@ -22,22 +23,53 @@
 /*~~~~~~~~~~~~~*/
 /*   g4fire   */
 /*~~~~~~~~~~~~~*/
+#include "g4fire/DarkBrem/G4eDarkBremsstrahlung.h"
 #include "g4fire/DetectorConstruction.h"
 #include "g4fire/Event/SimTrackerHit.h"
+#include "g4fire/PluginFactory.h"
 #include "g4fire/RunManager.h"
 #include "g4fire/UserEventInformation.h"
 #include "g4fire/UserTrackingAction.h"
+#include "g4fire/XsecBiasingOperator.h"
 
 /*~~~~~~~~~~~~*/
 /*   Geant4   */
 /*~~~~~~~~~~~~*/
+#include "G4BiasingProcessInterface.hh"
+#include "G4Electron.hh"
+#include "G4ProcessManager.hh"
 #include "G4Run.hh"
 #include "G4RunManager.hh"
 #include "G4RunManagerKernel.hh"
+#include "G4SDManager.hh"
 
 namespace g4fire {
 namespace persist {
 
+namespace {
+
+/**
+ * Find the dark brem process of the electron, wrapped for biasing or not.
+ *
+ * @return the process, nullptr if dark brem isn't simulated
+ */
+const darkbrem::G4eDarkBremsstrahlung *findDarkBrem() {
+  G4ProcessManager *manager{G4Electron::Electron()->GetProcessManager()};
+  if (!manager) return nullptr;
+  G4ProcessVector *processes{manager->GetProcessList()};
+  for (G4int i{0}; i < processes->size(); ++i) {
+    const G4VProcess *process{(*processes)[i]};
+    if (auto wrapper{dynamic_cast<const G4BiasingProcessInterface *>(process)})
+      process = wrapper->GetWrappedProcess();
+    if (auto dark_brem{
+            dynamic_cast<const darkbrem::G4eDarkBremsstrahlung *>(process)})
+      return dark_brem;
+  }
+  return nullptr;
+}
+
+}  // namespace
+
 RootPersistencyManager::RootPersistencyManager(
     framework::EventFile &file, framework::config::Parameters &parameters,
     const int &runNumber, ConditionsInterface &ci)
@@ -55,6 +87,21 @@ RootPersistencyManager::RootPersistencyManager(
 
   ecalHitIO_.configure(parameters_);
 
+  columnarOutput_ = parameters_.getParameter<bool>("columnar_output", false);
+
+  selection_ = CollectionSelection(
+      parameters_.getParameter<std::vector<std::string>>("drop_collections",
+                                                         {}),
+      parameters_.getParameter<std::vector<std::string>>(
+          "keep_collections_if_filtered", {}));
+
+  for (const auto &quantization :
+       parameters_.getParameter<std::vector<framework::config::Parameters>>(
+           "quantization", {})) {
+    HitQuantizer quantizer(quantization);
+    quantizers_.emplace(quantizer.getCollectionName(), quantizer);
+  }
+
   run_ = runNumber;
 }
 
@@ -81,6 +128,25 @@ G4bool RootPersistencyManager::Store(const G4Run *) {
   runHeader.setIntParameter("Event Count", eventsCompleted_);
   runHeader.setIntParameter("Events Began", eventsBegan_);
 
+  // The loopers are counted for every event, stored or not.
+  auto runManager{static_cast<RunManager *>(G4RunManager::GetRunManager())};
+  runHeader.setIntParameter("Looping Tracks Killed",
+                            runManager->getLoopingTracksKilled());
+  runHeader.setFloatParameter("Looping Energy Killed [MeV]",
+                              runManager->getLoopingEnergyKilled());
+
+  // The factors tuned during the warm-up are only known now.
+  for (const g4fire::XsecBiasingOperator *bop :
+       g4fire::PluginFactory::getInstance().getBiasingOperators()) {
+    if (bop->isFactorTuned()) {
+      runHeader.setFloatParameter(
+          "BiasOperator::" + bop->GetName() + "::Chosen Factor",
+          bop->getFactor());
+    }
+  }
+
+  for (const auto &quantizer : quantizers_) quantizer.second.record(runHeader);
+
   return true;
 }
 
@@ -111,6 +177,39 @@ void RootPersistencyManager::writeHeader(const G4Event *anEvent) {
                                 event_info->getPNEnergy());
   eventHeader.setFloatParameter("total_electronuclear_energy",
                                 event_info->getENEnergy());
+  eventHeader.setIntParameter("looping_tracks_killed",
+                              event_info->getLoopingTracksKilled());
+  eventHeader.setFloatParameter("looping_energy_killed",
+                                event_info->getLoopingEnergyKilled());
+
+  // Dark brems are only recorded when reweighting to other A' masses.
+  // Then every event gets a weight for each mass, 1 without a dark brem,
+  // and the kinematics of each of its dark brems, indexed in order.
+  auto dark_brem{findDarkBrem()};
+  if (dark_brem and !dark_brem->getReweightMasses().empty()) {
+    const auto &dark_brems{event_info->getDarkBrems()};
+    eventHeader.setIntParameter("dark_brem_count", dark_brems.size());
+    for (std::size_t i{0}; i < dark_brems.size(); ++i) {
+      std::string prefix{"dark_brem_" + std::to_string(i) + "_"};
+      eventHeader.setFloatParameter(prefix + "incident_energy",
+                                    dark_brems[i].incident_energy);
+      eventHeader.setFloatParameter(prefix + "atomic_a",
+                                    dark_brems[i].atomic_a);
+      eventHeader.setFloatParameter(prefix + "atomic_z",
+                                    dark_brems[i].atomic_z);
+      eventHeader.setFloatParameter(prefix + "aprime_energy",
+                                    dark_brems[i].aprime_energy);
+    }
+
+    const auto &mass_weights{event_info->getMassWeights()};
+    for (double mass : dark_brem->getReweightMasses()) {
+      auto weight{mass_weights.find(mass)};
+      std::ostringstream name;
+      name << "dark_brem_weight_" << mass << "MeV";
+      eventHeader.setFloatParameter(
+          name.str(), weight == mass_weights.end() ? 1. : weight->second);
+    }
+  }
 
   // Save the state of the random engine to an output stream. A string
   // is then extracted and saved to the event header.
@@ -127,12 +226,20 @@ void RootPersistencyManager::writeHitsCollections(
   // check for no hit collections for this event
   if (!hce) return;
 
+  auto event_info{
+      static_cast<UserEventInformation *>(anEvent->GetUserInformation())};
+
   // Loop over all hits collections.
   int nColl = hce->GetNumberOfCollections();
   for (int iColl = 0; iColl < nColl; iColl++) {
     // Get a hits collection and its name.
     G4VHitsCollection *hc = hce->GetHC(iColl);
     if (!hc) {
+      // the sensitive detectors of dropped collections are deactivated,
+      // so they never create their collection
+      if (selection_.isDropped(
+              G4SDManager::GetSDMpointer()->GetHCtable()->GetHCname(iColl)))
+        continue;
       EXCEPTION_RAISE("G4HitColl", "G4VHitsCollection indexed " +
                                        std::to_string(iColl) +
                                        " returned a nullptr.");
@@ -140,6 +247,9 @@ void RootPersistencyManager::writeHitsCollections(
 
     std::string collName = hc->GetName();
 
+    // Skip the conversion entirely if the collection isn't persisted
+    if (!selection_.keep(collName, event_info->passedFilter())) continue;
+
     if (dynamic_cast<G4TrackerHitsCollection *>(hc) != nullptr) {
       // Write G4TrackerHit collection to output SimTrackerHit collection.
       G4TrackerHitsCollection *trackerHitsColl =
@@ -148,7 +258,8 @@ void RootPersistencyManager::writeHitsCollections(
       writeTrackerHitsCollection(trackerHitsColl, outputColl);
 
       // Add hits collection to output event.
-      outputEvent->add(collName, outputColl);
+      addCollection<ldmx::SimTrackerHitColumns>(collName, outputColl,
+                                                outputEvent);
 
     } else if (dynamic_cast<G4CalorimeterHitsCollection *>(hc) != nullptr) {
       G4CalorimeterHitsCollection *calHitsColl =
@@ -165,7 +276,8 @@ void RootPersistencyManager::writeHitsCollections(
       }
 
       // Add hits collection to output event.
-      outputEvent->add(collName, outputColl);
+      addCollection<ldmx::SimCalorimeterHitColumns>(collName, outputColl,
+                                                    outputEvent);
     }  // switch on type of hit collection
 
   }  // loop through geant4 hit collections
@@ -192,6 +304,7 @@ void RootPersistencyManager::writeTrackerHitsCollection(
     simTrackerHit.setPathLength(g4hit->getPathLength());
     simTrackerHit.setTrackID(g4hit->getTrackID());
     simTrackerHit.setPdgID(g4hit->getPdgID());
+    simTrackerHit.setWeight(g4hit->getWeight());
     simTrackerHit.setPosition(position.x(), position.y(), position.z());
     simTrackerHit.setMomentum(momentum.x(), momentum.y(), momentum.z());
 
@@ -216,7 +329,8 @@ void RootPersistencyManager::writeCalorimeterHitsCollection(
     simHit.setID(g4hit->getID());
     simHit.addContrib(trackMap->findIncident(g4hit->getTrackID()),
                       g4hit->getTrackID(), g4hit->getPdgCode(),
-                      g4hit->getEdep(), g4hit->getTime());
+                      g4hit->getEdep(), g4hit->getTime(),
+                      g4hit->getWeight());
     simHit.setPosition(pos.x(), pos.y(), pos.z());
 
     outputColl.push_back(simHit);
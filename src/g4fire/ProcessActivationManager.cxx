@@ -0,0 +1,55 @@
+#include "g4fire/ProcessActivationManager.h"
+
+#include <algorithm>
+
+#include "G4BiasingProcessInterface.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4ProcessManager.hh"
+#include "G4ProcessVector.hh"
+
+namespace g4fire {
+
+ProcessActivationManager &ProcessActivationManager::getInstance() {
+  static ProcessActivationManager the_manager;
+  return the_manager;
+}
+
+void ProcessActivationManager::resolve(const G4VProcess *process,
+                                       const G4ParticleDefinition &particle) {
+  G4ProcessManager *manager{particle.GetProcessManager()};
+  if (!manager) return;
+
+  auto &entries{entries_[process]};
+  entries.erase(std::remove_if(entries.begin(), entries.end(),
+                               [manager](const Entry &entry) {
+                                 return entry.first == manager;
+                               }),
+                entries.end());
+
+  G4ProcessVector *processes{manager->GetProcessList()};
+  for (G4int i{0}; i < processes->size(); ++i) {
+    G4VProcess *candidate{(*processes)[i]};
+    auto wrapper{dynamic_cast<G4BiasingProcessInterface *>(candidate)};
+    if (candidate == process or
+        (wrapper and wrapper->GetWrappedProcess() == process))
+      entries.emplace_back(manager, i);
+  }
+}
+
+void ProcessActivationManager::deactivate(const G4VProcess *process) {
+  auto resolved{entries_.find(process)};
+  if (resolved == entries_.end()) return;
+  for (const auto &entry : resolved->second) {
+    if (!entry.first->GetProcessActivation(entry.second)) continue;
+    entry.first->SetProcessActivation(entry.second, false);
+    deactivated_.push_back(entry);
+  }
+}
+
+void ProcessActivationManager::reactivate() {
+  for (const auto &entry : deactivated_)
+    entry.first->SetProcessActivation(entry.second, true);
+  deactivated_.clear();
+}
+
+}  // namespace g4fire
@@ -1,25 +1,38 @@
 #include "g4fire/RunManager.h"
 
+#include <limits>
+#include <set>
+
 #include "FTFP_BERT.hh"
 #include "G4GDMLParser.hh"
 #include "G4GenericBiasingPhysics.hh"
 #include "G4ParallelWorldPhysics.hh"
-#include "G4ProcessTable.hh"
+#include "G4SDManager.hh"
 #include "G4VModularPhysicsList.hh"
 
+#include "fire/exception/Exception.h"
+
+#include "g4fire/AnalyticScoringPlanes.h"
 #include "g4fire/ConditionsInterface.h"
+#include "g4fire/CrossingFilter.h"
 #include "g4fire/DarkBrem/APrimePhysics.h"
 #include "g4fire/DarkBrem/G4eDarkBremsstrahlung.h" //for process name
 #include "g4fire/DetectorConstruction.h"
 #include "g4fire/GammaPhysics.h"
+#include "g4fire/Geo/AuxInfoReader.h"
+#include "g4fire/LooperPolicy.h"
 #include "g4fire/ParallelWorld.h"
+#include "g4fire/Persist/CollectionSelection.h"
 #include "g4fire/PluginFactory.h"
+#include "g4fire/ProcessActivationManager.h"
+#include "g4fire/ReadoutFilter.h"
 #include "g4fire/USteppingAction.h"
 #include "g4fire/UserRunAction.h"
 #include "g4fire/UserStackingAction.h"
 #include "g4fire/UserTrackingAction.h"
 #include "g4fire/PrimaryGeneratorAction.h"
 #include "g4fire/UserEventAction.h"
+#include "g4fire/UserEventInformation.h"
 
 namespace g4fire {
 
@@ -36,6 +49,8 @@ RunManager::RunManager(const fire::config::Parameters &params,
   // setUseRootSeed(rootPrimaryGenUseSeed);
 }
 
+RunManager::~RunManager() = default;
+
 void RunManager::setupPhysics() {
 
   std::cout << "setting up physics." << std::endl;
@@ -45,7 +60,10 @@ void RunManager::setupPhysics() {
       params_.get<fire::config::Parameters>("dark_brem")));*/
 
   parallel_world_path_ = params_.get<std::string>("parallel_world", {});
-  pw_enabled_ = !parallel_world_path_.empty();
+  analytic_scoring_planes_ =
+      params_.get<std::string>("scoring_planes_mode", "parallel_world") ==
+      "analytic";
+  pw_enabled_ = !parallel_world_path_.empty() and !analytic_scoring_planes_;
   if (pw_enabled_) {
     // TODO(OM) Use logger instead.
     std::cout
@@ -72,12 +90,25 @@ void RunManager::setupPhysics() {
 
     // Specify which particles are going to be biased. This will put a biasing
     // interface wrapper around *all* processes associated with these
-    // particles.
+    // particles. Operators that don't bias a process (e.g. weight windows)
+    // only need the non-physics wrapper, which Bias also adds.
+    std::set<std::string> physics_biased, non_physics_biased;
     for (const g4fire::XsecBiasingOperator *bop :
          g4fire::PluginFactory::getInstance().getBiasingOperators()) {
-      std::cout << "[ RunManager ]: Biasing operator '" << bop->GetName()
-                << "' set to bias " << bop->getParticleToBias() << std::endl;
-      biasing_physics->Bias(bop->getParticleToBias());
+      for (const std::string &particle : bop->getParticlesToBias()) {
+        std::cout << "[ RunManager ]: Biasing operator '" << bop->GetName()
+                  << "' set to bias " << particle << std::endl;
+        if (bop->getProcessToBias().empty())
+          non_physics_biased.insert(particle);
+        else
+          physics_biased.insert(particle);
+      }
+    }
+    for (const std::string &particle : physics_biased)
+      biasing_physics->Bias(particle);
+    for (const std::string &particle : non_physics_biased) {
+      if (!physics_biased.count(particle))
+        biasing_physics->NonPhysicsBias(particle);
     }
 
     // Register the physics constructor to the physics list:
@@ -110,6 +141,25 @@ void RunManager::Initialize() {
   G4RunManager::Initialize();
   std::cout << "done initializing." << std::endl;
 
+  // The scoring planes handled analytically only need their sensitive
+  // detectors, the volumes are never placed in any world.
+  if (analytic_scoring_planes_ and !parallel_world_path_.empty()) {
+    std::cout << "[ RunManager ]: Scoring plane crossings will be found "
+              << "analytically." << std::endl;
+    auto sp_parser{std::make_unique<G4GDMLParser>()};
+    sp_parser->Read(parallel_world_path_,
+                    params_.get<bool>("validate_detector"));
+    g4fire::geo::AuxInfoReader(sp_parser.get(), params_, conditions_intf_)
+        .readGlobalAuxInfo();
+    scoring_planes_ = std::make_unique<AnalyticScoringPlanes>(sp_parser.get());
+  }
+
+  // All sensitive detectors have been constructed now, deactivate the ones
+  // whose hits will never be persisted
+  deactivateDroppedCollections();
+  configureReadoutFilters();
+  configureCrossingFilters();
+
   // Instantiate the primary generator action
   auto primaryGeneratorAction{new PrimaryGeneratorAction(params_)};
   SetUserAction(primaryGeneratorAction);
@@ -127,6 +177,20 @@ void RunManager::Initialize() {
         userAction.get<std::string>("instance_name"), userAction);
   }
 
+  if (scoring_planes_) {
+    std::get<USteppingAction *>(actions[TYPE::STEPPING])
+        ->setScoringPlanes(scoring_planes_.get());
+  }
+
+  auto looper_policy{
+      params_.get<std::vector<fire::config::Parameters>>("looper_policy", {})};
+  if (!looper_policy.empty()) {
+    looper_policy_ = std::make_unique<LooperPolicy>(looper_policy);
+    looper_policy_->configureTransportation();
+    std::get<USteppingAction *>(actions[TYPE::STEPPING])
+        ->setLooperPolicy(looper_policy_.get());
+  }
+
   // Register all actions with the G4 engine
   for (const auto &[key, act] : actions) {
     std::visit([this](auto &&arg) { this->SetUserAction(arg); }, act);
@@ -134,36 +198,103 @@ void RunManager::Initialize() {
 }
 
 void RunManager::TerminateOneEvent() {
+  // count the loopers of every event, whether it is stored or not
+  if (currentEvent) {
+    auto event_info{static_cast<UserEventInformation *>(
+        currentEvent->GetUserInformation())};
+    if (event_info) {
+      looping_tracks_killed_ += event_info->getLoopingTracksKilled();
+      looping_energy_killed_ += event_info->getLoopingEnergyKilled();
+    }
+  }
+
   // have geant4 do its own thing
   G4RunManager::TerminateOneEvent();
 
-  // reset dark brem process (if needed)
-  G4ProcessTable *ptable = G4ProcessTable::GetProcessTable();
-  G4int verbosity = ptable->GetVerboseLevel();
-
-  // Only one of these processes should be in the table
-  //  (i.e. either the Dark Brem is biased or its not)
-  // BUT we want to be able to cover both options without
-  // the user having to configure it, so we set both
-  // of these processes to active (by passing 'true')
-  // while the table is silenced. If the table isn't silenced,
-  // the process that isn't in the table will cause the table
-  // to throw a "not found" warning.
-  /*std::vector<G4String> dark_brem_processes = {
-      darkbrem::G4eDarkBremsstrahlung::PROCESS_NAME,
-      "biasWrapper(" + darkbrem::G4eDarkBremsstrahlung::PROCESS_NAME + ")"};
-  ptable->SetVerboseLevel(
-      0); // silent ptable while searching for process that may/may not exist
-  for (auto const &name : dark_brem_processes)
-    ptable->SetProcessActivation(name, true);
-  ptable->SetVerboseLevel(verbosity);
-  -- Up-to-date: /home/omoreno/projects/ldmx/softwa
+  // reset the processes that were switched off during the event (if any)
+  ProcessActivationManager::getInstance().reactivate();
   if (this->GetVerboseLevel() > 1) {
     std::cout << "[ RunManager ] : "
-              << "Reset the dark brem process (if it was activated)."
+              << "Reset the dark brem process (if it was deactivated)."
               << std::endl;
   }
-  ptable->SetVerboseLevel(verbosity); */
+}
+
+void RunManager::RunInitialization() {
+  G4RunManager::RunInitialization();
+  looping_tracks_killed_ = 0;
+  looping_energy_killed_ = 0.;
+}
+
+void RunManager::deactivateDroppedCollections() {
+  persist::CollectionSelection selection(
+      params_.get<std::vector<std::string>>("drop_collections", {}));
+
+  // A sensitive detector can only be deactivated if all of its
+  // collections are dropped
+  auto sd_manager{G4SDManager::GetSDMpointer()};
+  auto hc_table{sd_manager->GetHCtable()};
+  std::map<std::string, bool> all_dropped;
+  for (int i_coll{0}; i_coll < hc_table->entries(); ++i_coll) {
+    std::string sd_name{hc_table->GetSDname(i_coll)};
+    bool dropped{selection.isDropped(hc_table->GetHCname(i_coll))};
+    auto [sd, inserted] = all_dropped.emplace(sd_name, dropped);
+    if (!inserted) sd->second = sd->second and dropped;
+  }
+
+  for (const auto &[sd_name, dropped] : all_dropped) {
+    if (!dropped) continue;
+    sd_manager->Activate(sd_name, false);
+    std::cout << "[ RunManager ]: Deactivated sensitive detector '" << sd_name
+              << "' since all of its collections are dropped." << std::endl;
+  }
+}
+
+void RunManager::configureReadoutFilters() {
+  auto readout_filters{
+      params_.get<std::vector<fire::config::Parameters>>("readout_filters", {})};
+  for (const auto &readout : readout_filters) {
+    auto sd_name{readout.get<std::string>("sensitive_detector")};
+    auto sd{G4SDManager::GetSDMpointer()->FindSensitiveDetector(sd_name)};
+    auto filter{dynamic_cast<ReadoutFilter *>(sd)};
+    if (!filter) {
+      throw fire::Exception("Config",
+                            "Sensitive detector '" + sd_name +
+                                "' does not exist or does not support "
+                                "readout filters.",
+                            false);
+    }
+
+    filter->setReadoutWindow(
+        readout.get<double>("min_time", -std::numeric_limits<double>::max()),
+        readout.get<double>("max_time", std::numeric_limits<double>::max()));
+    filter->setEnergyThreshold(readout.get<double>("threshold", 0.));
+    std::cout << "[ RunManager ]: Configured readout filter of sensitive "
+              << "detector '" << sd_name << "'." << std::endl;
+  }
+}
+
+void RunManager::configureCrossingFilters() {
+  auto crossing_filters{params_.get<std::vector<fire::config::Parameters>>(
+      "scoring_plane_filters", {})};
+  for (const auto &crossing : crossing_filters) {
+    auto sd_name{crossing.get<std::string>("sensitive_detector")};
+    auto sd{G4SDManager::GetSDMpointer()->FindSensitiveDetector(sd_name)};
+    auto filter{dynamic_cast<CrossingFilter *>(sd)};
+    if (!filter) {
+      throw fire::Exception("Config",
+                            "Sensitive detector '" + sd_name +
+                                "' does not exist or is not a scoring plane.",
+                            false);
+    }
+
+    filter->setFirstCrossingOnly(
+        crossing.get<bool>("first_crossing_only", false));
+    filter->setPdgIDs(crossing.get<std::vector<int>>("pdg_ids", {}));
+    filter->setMinMomentum(crossing.get<double>("min_momentum", 0.));
+    std::cout << "[ RunManager ]: Configured crossing filter of scoring "
+              << "plane '" << sd_name << "'." << std::endl;
+  }
 }
 
 DetectorConstruction *RunManager::getDetectorConstruction() {
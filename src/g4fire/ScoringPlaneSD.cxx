@@ -5,6 +5,7 @@
 /*----------------*/
 /*   C++ StdLib   */
 /*----------------*/
+#include <cmath>
 #include <iostream>
 
 /*~~~~~~~~~~~~*/
@@ -16,6 +17,8 @@
 #include "G4Step.hh"
 #include "G4StepPoint.hh"
 
+#include "g4fire/UserTrackInformation.h"
+
 namespace g4fire {
 
 ScoringPlaneSD::ScoringPlaneSD(G4String name, G4String colName, int subDetID)
@@ -32,6 +35,16 @@ ScoringPlaneSD::ScoringPlaneSD(G4String name, G4String colName, int subDetID)
 ScoringPlaneSD::~ScoringPlaneSD() {}
 
 G4bool ScoringPlaneSD::ProcessHits(G4Step* step, G4TouchableHistory* history) {
+  G4StepPoint* prePoint = step->GetPreStepPoint();
+  G4StepPoint* postPoint = step->GetPostStepPoint();
+  int cpNumber = prePoint->GetTouchableHandle()->GetCopyNumber();
+
+  // When only recording the first crossing, describe the track where it
+  // entered the plane. Otherwise, describe it at the end of the step.
+  G4StepPoint* point = isFirstCrossingOnly() ? prePoint : postPoint;
+  if (!acceptCrossing(step->GetTrack(), point->GetMomentum().mag(), cpNumber))
+    return false;
+
   // Get the edep from the step.
   G4double edep = step->GetTotalEnergyDeposit();
 
@@ -41,22 +54,17 @@ G4bool ScoringPlaneSD::ProcessHits(G4Step* step, G4TouchableHistory* history) {
   // Assign track ID for finding the SimParticle in post event processing.
   hit->setTrackID(step->GetTrack()->GetTrackID());
   hit->setPdgID(step->GetTrack()->GetDynamicParticle()->GetPDGcode());
+  hit->setWeight(UserTrackInformation::getHitWeight(step->GetTrack()));
 
   // Set the edep.
   hit->setEdep(edep);
 
-  // Set the start position.
-  G4StepPoint* prePoint = step->GetPreStepPoint();
-
-  // Set the end position.
-  G4StepPoint* postPoint = step->GetPostStepPoint();
-
   G4ThreeVector start = prePoint->GetPosition();
   G4ThreeVector end = postPoint->GetPosition();
 
-  // Set the mid position.
-  G4ThreeVector mid = 0.5 * (start + end);
-  hit->setPosition(mid.x(), mid.y(), mid.z());
+  // Set the mid position (or the entry position for first crossings).
+  G4ThreeVector pos = isFirstCrossingOnly() ? start : 0.5 * (start + end);
+  hit->setPosition(pos.x(), pos.y(), pos.z());
 
   // Compute path length.
   G4double pathLength =
@@ -65,17 +73,16 @@ G4bool ScoringPlaneSD::ProcessHits(G4Step* step, G4TouchableHistory* history) {
   hit->setPathLength(pathLength);
 
   // Set the global time.
-  hit->setTime(step->GetTrack()->GetGlobalTime());
+  hit->setTime(point->GetGlobalTime());
 
   // Set the momentum
-  G4ThreeVector p = postPoint->GetMomentum();
+  G4ThreeVector p = point->GetMomentum();
   hit->setMomentum(p.x(), p.y(), p.z());
-  hit->setEnergy(postPoint->GetTotalEnergy());
+  hit->setEnergy(point->GetTotalEnergy());
 
   /*
    * Set the 32-bit ID on the hit.
    */
-  int cpNumber = prePoint->GetTouchableHandle()->GetCopyNumber();
   ldmx::SimSpecialID id = ldmx::SimSpecialID::ScoringPlaneID(cpNumber);
   hit->setID(id.raw());
 
@@ -93,7 +100,53 @@ G4bool ScoringPlaneSD::ProcessHits(G4Step* step, G4TouchableHistory* history) {
   return true;
 }
 
+void ScoringPlaneSD::recordCrossing(const G4Step* step,
+                                    const G4ThreeVector& position,
+                                    double fraction, int plane) {
+  // Sensitive detectors can be deactivated, e.g. if their collection is
+  // dropped, in which case there is no hits collection to fill.
+  if (!isActive()) return;
+
+  G4StepPoint* prePoint = step->GetPreStepPoint();
+  G4StepPoint* postPoint = step->GetPostStepPoint();
+  G4ThreeVector preMomentum = prePoint->GetMomentum();
+  G4ThreeVector postMomentum = postPoint->GetMomentum();
+  G4double momentum =
+      preMomentum.mag() + fraction * (postMomentum.mag() - preMomentum.mag());
+  if (!acceptCrossing(step->GetTrack(), momentum, plane)) return;
+
+  G4ThreeVector direction = prePoint->GetMomentumDirection() +
+                            fraction * (postPoint->GetMomentumDirection() -
+                                        prePoint->GetMomentumDirection());
+  G4ThreeVector p = momentum * direction.unit();
+  G4double mass = step->GetTrack()->GetDynamicParticle()->GetMass();
+
+  G4TrackerHit* hit = new G4TrackerHit();
+  hit->setTrackID(step->GetTrack()->GetTrackID());
+  hit->setPdgID(step->GetTrack()->GetDynamicParticle()->GetPDGcode());
+  hit->setWeight(UserTrackInformation::getHitWeight(step->GetTrack()));
+  hit->setEdep(0.);
+  hit->setPosition(position.x(), position.y(), position.z());
+  hit->setPathLength(0.);
+  hit->setTime(prePoint->GetGlobalTime() +
+               fraction * (postPoint->GetGlobalTime() -
+                           prePoint->GetGlobalTime()));
+  hit->setMomentum(p.x(), p.y(), p.z());
+  hit->setEnergy(std::sqrt(momentum * momentum + mass * mass));
+  ldmx::SimSpecialID id = ldmx::SimSpecialID::ScoringPlaneID(plane);
+  hit->setID(id.raw());
+
+  if (this->verboseLevel > 2) {
+    hit->Print();
+    std::cout << std::endl;
+  }
+
+  hitsCollection_->insert(hit);
+}
+
 void ScoringPlaneSD::Initialize(G4HCofThisEvent* hce) {
+  clearCrossings();
+
   // Setup hits collection and the HC ID.
   hitsCollection_ =
       new G4TrackerHitsCollection(SensitiveDetectorName, collectionName[0]);
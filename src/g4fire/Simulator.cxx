@@ -117,6 +117,10 @@ void Simulator::configure(const fire::config::Parameters &params) {
 }*/
 
 void Simulator::beforeNewRun(fire::RunHeader &header) {
+  // the run header is only written once the run is over, keep it to add
+  // the run totals as the events are processed
+  run_header_ = &header;
+
   // Get the detector header from the user detector construction
   DetectorConstruction *detector =
       static_cast<RunManager *>(RunManager::GetRunManager())
@@ -168,7 +172,7 @@ void Simulator::beforeNewRun(fire::RunHeader &header) {
 
   auto bops{PluginFactory::getInstance().getBiasingOperators()};
   for (const XsecBiasingOperator *bop : bops) {
-    // bop->RecordConfig(header);
+    bop->RecordConfig(header);
   }
 
   /*auto dark_brem{params_.get<fire::config::Parameters>("dark_brem")};
@@ -285,6 +289,7 @@ void Simulator::process(fire::Event &event) {
   // the next event.
   if (run_manager_->GetCurrentEvent()->IsAborted()) {
     run_manager_->TerminateOneEvent();  // clean up event objects
+    updateRunHeader();
     this->abortEvent();                // get out of processors loop
   }
 
@@ -301,6 +306,7 @@ void Simulator::process(fire::Event &event) {
   // stacked for later.
   n_events_completed_++;
   run_manager_->TerminateOneEvent();
+  updateRunHeader();
 
   return; 
 }
@@ -390,6 +396,24 @@ void Simulator::onProcessEnd() {
   session_handle_.reset(nullptr);
 }
 
+void Simulator::updateRunHeader() {
+  if (!run_header_) return;
+  run_header_->set<int>("Looping Tracks Killed",
+                        run_manager_->getLoopingTracksKilled());
+  run_header_->set<float>("Looping Energy Killed [MeV]",
+                          run_manager_->getLoopingEnergyKilled());
+
+  // the factors tuned during the warm-up are only known once it is over
+  for (const XsecBiasingOperator *bop :
+       PluginFactory::getInstance().getBiasingOperators()) {
+    if (bop->isFactorTuned()) {
+      run_header_->set<float>(
+          "BiasOperator::" + bop->GetName() + "::Chosen Factor",
+          bop->getFactor());
+    }
+  }
+}
+
 bool Simulator::allowed(const std::string &command) const {
   for (const std::string &invalid_substring : invalid_cmds) {
     if (command.find(invalid_substring) != std::string::npos) {
@@ -10,6 +10,8 @@
 #include "G4Step.hh"
 #include "G4StepPoint.hh"
 
+#include "g4fire/UserTrackInformation.h"
+
 // LDMX
 #include "DetDescr/IDField.h"
 
@@ -50,6 +52,9 @@ G4bool TrackerSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
     return false;
   }
 
+  // Skip steps that happen outside of the readout window.
+  if (!isInReadoutWindow(aStep)) return false;
+
   // Create a new hit object.
   G4TrackerHit* hit = new G4TrackerHit();
 
@@ -112,6 +117,9 @@ G4bool TrackerSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
   hit->setEnergy(postPoint->GetTotalEnergy());
   hit->setPdgID(aStep->GetTrack()->GetDynamicParticle()->GetPDGcode());
 
+  // Set the weight of the track, it differs from one when biasing splits it.
+  hit->setWeight(UserTrackInformation::getHitWeight(aStep->GetTrack()));
+
   /*
    * Debug print.
    */
@@ -134,6 +142,9 @@ void TrackerSD::Initialize(G4HCofThisEvent* hce) {
 }
 
 void TrackerSD::EndOfEvent(G4HCofThisEvent*) {
+  // Remove the hits in sensors below the zero-suppression threshold
+  suppress(hitsCollection_);
+
   // Print number of hits.
   if (this->verboseLevel > 0) {
     std::cout << GetName() << " had " << hitsCollection_->entries()
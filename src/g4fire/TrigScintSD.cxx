@@ -14,6 +14,8 @@
 #include "G4Step.hh"
 #include "G4StepPoint.hh"
 
+#include "g4fire/UserTrackInformation.h"
+
 namespace g4fire {
 
 TrigScintSD::TrigScintSD(G4String name, G4String theCollectionName,
@@ -33,6 +35,9 @@ G4bool TrigScintSD::ProcessHits(G4Step* step, G4TouchableHistory* history) {
                         (particleDef != G4ChargedGeantino::Definition())))
     return false;
 
+  // Skip steps that happen outside of the readout window.
+  if (!isInReadoutWindow(step)) return false;
+
   // Create a new instance of a calorimeter hit
   auto hit{new G4CalorimeterHit()};
 
@@ -67,6 +72,9 @@ G4bool TrigScintSD::ProcessHits(G4Step* step, G4TouchableHistory* history) {
   // Set the PDG code from the track.
   hit->setPdgCode(track->GetParticleDefinition()->GetPDGEncoding());
 
+  // Set the weight of the track, it differs from one when biasing splits it.
+  hit->setWeight(UserTrackInformation::getHitWeight(track));
+
   hitsCollection_->insert(hit);
 
   return true;
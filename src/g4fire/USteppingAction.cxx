@@ -1,5 +1,7 @@
 #include "g4fire/USteppingAction.h"
 
+#include "g4fire/UserTrackInformation.h"
+
 namespace g4fire {
 
 void USteppingAction::UserSteppingAction(const G4Step *step) {
@@ -17,8 +19,19 @@ void USteppingAction::UserSteppingAction(const G4Step *step) {
 
   event_info->incWeight(weight_of_this_step_alone);
 
+  // the secondaries start with the part of the track weight that is
+  // already in the event weight, so their hits are not weighted twice
+  auto track_info{UserTrackInformation::get(step->GetTrack())};
+  track_info->foldWeight(weight_of_this_step_alone);
+
   const std::vector<const G4Track *> *secondaries{
       step->GetSecondaryInCurrentStep()};
+  if (secondaries) {
+    for (const G4Track *secondary : *secondaries) {
+      UserTrackInformation::get(secondary)->setFoldedWeight(
+          track_info->getFoldedWeight());
+    }
+  }
 
   /**
    * Reset PN/EN flags and updating running energy totals
@@ -49,6 +62,9 @@ void USteppingAction::UserSteppingAction(const G4Step *step) {
       }          // creator exists
     }            // loop over secondaries
   }              // secondaries list was created
+  if (scoring_planes_) scoring_planes_->stepping(step);
+  if (looper_policy_) looper_policy_->stepping(step);
+
   // now stepping actions can use getEventInfo()->wasLastStep{P,E}N()
   //  to determine if last step was PN or EN
   for (auto &stepping_action : stepping_actions_)
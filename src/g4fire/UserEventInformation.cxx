@@ -8,7 +8,9 @@ void UserEventInformation::Print() const {
   std::cout << "Event weight: " << weight_ << "\n"
             << "Brem candidate count: " << brem_candidate_count_ << "\n"
             << "E_{PN} = " << total_photonuclear_energy_ << " MeV  "
-            << "E_{EN} = " << total_electronuclear_energy_ << " MeV"
-            << std::endl;
+            << "E_{EN} = " << total_electronuclear_energy_ << " MeV\n"
+            << "Killed loopers: " << looping_tracks_killed_ << " carrying "
+            << looping_energy_killed_ << " MeV\n"
+            << "Dark brems recorded: " << dark_brems_.size() << std::endl;
 }
 }  // namespace g4fire
@@ -11,6 +11,10 @@ UserTrackInformation* UserTrackInformation::get(const G4Track* track) {
   return dynamic_cast<UserTrackInformation*>(track->GetUserInformation());
 }
 
+double UserTrackInformation::getHitWeight(const G4Track* track) {
+  return track->GetWeight() / get(track)->getFoldedWeight();
+}
+
 void UserTrackInformation::initialize(const G4Track* track) {
   initial_momentum_ = track->GetMomentum(); 
   vertex_volume_ = track->GetLogicalVolumeAtVertex()->GetName();
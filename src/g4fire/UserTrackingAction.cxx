@@ -34,6 +34,11 @@ void UserTrackingAction::PreUserTrackingAction(const G4Track* track) {
               ->GetPrimaryParticle()
               ->GetUserInformation());
       cur_gen_status = primaryInfo->getHepEvtStatus();
+
+      // the weight of the primary vertex is already in the event weight
+      track_info->setFoldedWeight(
+          track->GetWeight() /
+          track->GetDynamicParticle()->GetPrimaryParticle()->GetWeight());
     }
 
     /**
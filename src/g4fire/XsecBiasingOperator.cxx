@@ -1,13 +1,40 @@
 #include "g4fire/XsecBiasingOperator.h"
 
-//#include "Framework/Exception/Exception.h"
+#include <algorithm>
+#include <cfloat>
+#include <iostream>
+
+#include "G4Event.hh"
+#include "G4EventManager.hh"
+#include "G4Run.hh"
+#include "G4RunManager.hh"
+
+#include "fire/exception/Exception.h"
+
 #include "g4fire/PluginFactory.h"
 
 namespace g4fire {
 
 XsecBiasingOperator::XsecBiasingOperator(
-    std::string name, const fire::config::Parameters& params)
-    : G4VBiasingOperator(name) {}
+    std::string name, const fire::config::Parameters& params,
+    bool factor_required)
+    : G4VBiasingOperator(name) {
+  for (double factor :
+       params.get<std::vector<double>>("adaptive_factors", {}))
+    candidates_.push_back({factor});
+  // the factor is only a fallback when it is tuned
+  if (factor_required and candidates_.empty())
+    factor_ = params.get<double>("factor");
+  else
+    factor_ = params.get<double>("factor", 1.);
+  configured_factor_ = factor_;
+  warm_up_events_ = params.get<int>("warm_up_events", 100);
+  if (!candidates_.empty() and warm_up_events_ < 1) {
+    throw fire::Exception("BiasSetup",
+                          "The number of warm up events must be positive.",
+                          false);
+  }
+}
 
 XsecBiasingOperator::~XsecBiasingOperator() {}
 
@@ -29,7 +56,16 @@ void XsecBiasingOperator::StartRun() {
   std::cout << "[ XsecBiasingOperator ]: Biasing particles of type "
             << this->getParticleToBias() << std::endl;
 
-  if (processIsBiased(this->getProcessToBias())) {
+  // restart the warm-up of the factor (if any)
+  factor_ = configured_factor_;
+  for (auto &candidate : candidates_) candidate = {candidate.factor};
+  phase_ = 0;
+  current_event_ = -1;
+  current_score_ = 0.;
+  factor_tuned_ = false;
+
+  biased_process_ = findBiasedProcess(this->getProcessToBias());
+  if (biased_process_) {
     xsec_operation_ =
         new G4BOptnChangeCrossSection("changeXsec-" + this->getProcessToBias());
   } else {
@@ -39,25 +75,102 @@ void XsecBiasingOperator::StartRun() {
   }
 }
 
-bool XsecBiasingOperator::processIsBiased(std::string process) {
-  // Loop over all processes and check if the given process is being
-  // biased.
+const G4VProcess* XsecBiasingOperator::findBiasedProcess(
+    const std::string& process) const {
+  // Loop over all processes and return the wrapped process with the
+  // given name.
   const G4BiasingProcessSharedData* shared_data{
       G4BiasingProcessInterface::GetSharedData(process_manager_)};
   if (shared_data) {
-    for (size_t iprocess = 0;
-         iprocess < (shared_data->GetPhysicsBiasingProcessInterfaces()).size();
-         ++iprocess) {
-      const G4BiasingProcessInterface* wrapperProcess =
-          (shared_data->GetPhysicsBiasingProcessInterfaces())[iprocess];
-
-      if (wrapperProcess->GetWrappedProcess()->GetProcessName().compareTo(
-              process) == 0) {
-        return true;
-      }
+    for (const G4BiasingProcessInterface* wrapperProcess :
+         shared_data->GetPhysicsBiasingProcessInterfaces()) {
+      const G4VProcess* wrapped{wrapperProcess->GetWrappedProcess()};
+      if (wrapped->GetProcessName().compareTo(process) == 0) return wrapped;
+    }
+  }
+  return nullptr;
+}
+
+void XsecBiasingOperator::tuneFactor() {
+  if (candidates_.empty() or factor_tuned_) return;
+
+  int event_id{
+      G4EventManager::GetEventManager()->GetConstCurrentEvent()->GetEventID()};
+  if (event_id == current_event_) return;
+
+  if (current_event_ < 0) {
+    // first event of the run, start with the first factor
+    phase_start_ = std::chrono::steady_clock::now();
+  } else {
+    // a new event started, so the score of the previous one is complete
+    auto &candidate{candidates_[phase_]};
+    candidate.sum_score += current_score_;
+    candidate.sum_score2 += current_score_ * current_score_;
+  }
+  current_event_ = event_id;
+  current_score_ = 0.;
+
+  // the event IDs are given by the framework and may not start at zero,
+  // the run counts the events that were completed before this one
+  std::size_t phase = G4RunManager::GetRunManager()->GetCurrentRun()
+                          ->GetNumberOfEvent() /
+                      warm_up_events_;
+  if (phase != phase_) {
+    auto now{std::chrono::steady_clock::now()};
+    candidates_[phase_].seconds +=
+        std::chrono::duration<double>(now - phase_start_).count();
+    phase_start_ = now;
+    phase_ = phase;
+  }
+
+  if (phase_ < candidates_.size()) {
+    factor_ = candidates_[phase_].factor;
+  } else {
+    chooseFactor();
+  }
+}
+
+void XsecBiasingOperator::rejectFactor() {
+  if (candidates_.empty() or factor_tuned_) return;
+  candidates_[phase_].rejected = true;
+}
+
+void XsecBiasingOperator::OperationApplied(
+    const G4BiasingProcessInterface *calling_process, G4BiasingAppliedCase,
+    G4VBiasingOperation *occurence_operation_applied,
+    G4double weight_for_occurence_interaction, G4VBiasingOperation *,
+    const G4VParticleChange *) {
+  if (candidates_.empty() or factor_tuned_) return;
+  if (occurence_operation_applied != xsec_operation_) return;
+  current_score_ += calling_process->GetCurrentTrack()->GetWeight() *
+                    weight_for_occurence_interaction;
+}
+
+void XsecBiasingOperator::chooseFactor() {
+  factor_tuned_ = true;
+  factor_ = configured_factor_;
+
+  double best_merit{0.};
+  for (const auto &candidate : candidates_) {
+    double mean{candidate.sum_score / warm_up_events_};
+    double variance{candidate.sum_score2 / warm_up_events_ - mean * mean};
+    double merit{0.};
+    if (!candidate.rejected and mean > 0.) {
+      merit = mean * mean / (std::max(variance, DBL_MIN) *
+                             std::max(candidate.seconds, DBL_MIN));
+    }
+    std::cout << "[ XsecBiasingOperator ]: " << GetName() << " factor "
+              << candidate.factor << " -> mean " << mean << ", variance "
+              << variance << ", time " << candidate.seconds << " s"
+              << (candidate.rejected ? ", too large" : "") << std::endl;
+    if (merit > best_merit) {
+      best_merit = merit;
+      factor_ = candidate.factor;
     }
   }
-  return false;
+
+  std::cout << "[ XsecBiasingOperator ]: " << GetName() << " chose factor "
+            << factor_ << " after the warm-up." << std::endl;
 }
 
 void XsecBiasingOperator::declare(const std::string& class_name,
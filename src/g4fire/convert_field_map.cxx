@@ -0,0 +1,83 @@
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+//------------//
+//   g4fire   //
+//------------//
+#include "g4fire/MagneticFieldMap3D.h"
+
+/**
+ * @func printUsage
+ *
+ * Print how to use this executable to the terminal.
+ */
+void printUsage();
+
+/**
+ * The executable main for converting a text field map to a binary one.
+ */
+int main(int argc, char* argv[]) {
+  bool single_precision{false};
+  std::string mirror_x, mirror_y;
+  std::vector<std::string> files;
+  for (int i_arg = 1; i_arg < argc; i_arg++) {
+    std::string arg{argv[i_arg]};
+    if (arg == "-h" or arg == "--help") {
+      printUsage();
+      return 0;
+    } else if (arg == "--float") {
+      single_precision = true;
+    } else if ((arg == "--mirror-x" or arg == "--mirror-y") and
+               i_arg + 1 < argc) {
+      (arg == "--mirror-x" ? mirror_x : mirror_y) = argv[++i_arg];
+    } else {
+      files.push_back(arg);
+    }
+  }
+
+  if (files.size() < 1 or files.size() > 2) {
+    printUsage();
+    return 1;
+  }
+
+  // the default output name is the one picked up automatically
+  // when the geometry refers to the text map
+  std::string output{files.size() == 2 ? files.at(1) : files.at(0) + ".bin"};
+
+  try {
+    g4fire::MagneticFieldMap3D field_map(files.at(0).c_str(), 0., 0., 0.,
+                                         single_precision, mirror_x,
+                                         mirror_y);
+    field_map.writeBinary(output);
+  } catch (const std::exception& e) {
+    std::cerr << "Unable to convert '" << files.at(0)
+              << "': " << e.what() << std::endl;
+    return 2;
+  }
+
+  std::cout << "Wrote binary field map to '" << output << "'." << std::endl;
+  return 0;
+}
+
+void printUsage() {
+  std::cout << "Usage: convert-field-map [--float] [--mirror-x SIGNS] "
+               "[--mirror-y SIGNS] {field_map.dat} [{field_map.dat.bin}]"
+            << std::endl;
+  std::cout << "     field_map.dat      (required) text field map to convert"
+            << std::endl;
+  std::cout << "     field_map.dat.bin  (optional) binary field map to write,"
+               " defaults to the input with '.bin' appended"
+            << std::endl;
+  std::cout << "     --float            store the values in single precision"
+            << std::endl;
+  std::cout << "     --mirror-x SIGNS   only store x >= 0, SIGNS are the signs"
+               " of the field components for x < 0 (e.g. -++)"
+            << std::endl;
+  std::cout << "     --mirror-y SIGNS   only store y >= 0, as for x"
+            << std::endl;
+}